@@ -0,0 +1,47 @@
+#version 330 core
+
+out vec4 color;
+
+// Tile atlas, and the tile id of every cell
+uniform sampler2D tiles;
+uniform usampler2D cells;
+
+uniform vec2 screen_size;
+uniform vec2 board_origin;
+uniform float tile_size;
+// Atlas rectangle of each tile: top left uv, bottom right uv
+uniform vec4 tile_uv[16];
+uniform ivec2 board_size;
+uniform ivec2 cursor;
+uniform uint cursor_tile;
+
+vec4 sample_tile(uint tile, vec2 local, vec2 dx, vec2 dy) {
+     vec4 uv = tile_uv[tile];
+     vec2 size = uv.zw - uv.xy;
+     // Gradients of the continuous board position, so the jump in the local
+     // coordinate at tile edges doesn't select the wrong mip level
+     return textureGrad(tiles, mix(uv.xy, uv.zw, local), dx * size,
+                        dy * size);
+}
+
+void main() {
+     // Window pixels, origin top left, to board cells
+     vec2 pixel = vec2(gl_FragCoord.x, screen_size.y - gl_FragCoord.y);
+     vec2 board_position = (pixel - board_origin) / tile_size;
+     vec2 dx = dFdx(board_position);
+     vec2 dy = dFdy(board_position);
+
+     ivec2 cell = ivec2(floor(board_position));
+     if (any(lessThan(cell, ivec2(0))) ||
+         any(greaterThanEqual(cell, board_size))) {
+          discard;
+     }
+     vec2 local = fract(board_position);
+
+     uint tile = texelFetch(cells, cell, 0).r;
+     color = sample_tile(tile, local, dx, dy);
+     if (cell == cursor) {
+          vec4 overlay = sample_tile(cursor_tile, local, dx, dy);
+          color = mix(color, overlay, overlay.a);
+     }
+}
@@ -0,0 +1,7 @@
+#version 330 core
+
+void main() {
+     // Full-screen triangle strip from the vertex index alone
+     vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+     gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
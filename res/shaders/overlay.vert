@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec4 color;
+
+uniform vec2 screen_size;
+
+out vec4 vertexColor;
+
+void main() {
+     // Pixels, origin top left, to normalized device coordinates
+     vec2 ndc = position / screen_size * 2.0 - 1.0;
+     gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+     vertexColor = color;
+}
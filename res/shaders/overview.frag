@@ -0,0 +1,33 @@
+#version 330 core
+
+out vec4 color;
+
+// Board_Pyramid: revealed, flagged and revealed mine fractions in r, g, b
+uniform sampler2D summary;
+
+uniform vec2 screen_size;
+uniform vec2 board_origin;
+uniform float tile_size;
+uniform vec2 board_size;
+
+const vec3 hidden_color = vec3(0.45);
+const vec3 revealed_color = vec3(0.80);
+const vec3 flag_color = vec3(1.0, 0.0, 0.0);
+const vec3 mine_color = vec3(0.0);
+
+void main() {
+     // Window pixels, origin top left, to board cells
+     vec2 pixel = vec2(gl_FragCoord.x, screen_size.y - gl_FragCoord.y);
+     vec2 board_position = (pixel - board_origin) / tile_size;
+     if (any(lessThan(board_position, vec2(0.0))) ||
+         any(greaterThanEqual(board_position, board_size))) {
+          discard;
+     }
+
+     // Trilinear filtering picks the level with about a texel per pixel
+     vec3 fractions = texture(summary, board_position / board_size).rgb;
+     vec3 c = mix(hidden_color, revealed_color, fractions.r);
+     c = mix(c, flag_color, fractions.g);
+     c = mix(c, mine_color, fractions.b);
+     color = vec4(c, 1.0);
+}
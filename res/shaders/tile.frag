@@ -0,0 +1,10 @@
+#version 330 core
+
+in vec2 texCoord;
+out vec4 color;
+
+uniform sampler2D tiles;
+
+void main() {
+    color = texture(tiles, texCoord);
+}
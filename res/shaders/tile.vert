@@ -0,0 +1,24 @@
+#version 330 core
+// Unit quad corner, shared by every instance
+layout (location = 0) in vec2 corner;
+// Per instance
+layout (location = 1) in uvec2 cell;
+layout (location = 2) in uint tile;
+
+uniform vec2 screen_size;
+uniform vec2 board_origin;
+uniform float tile_size;
+// Atlas rectangle of each tile: top left uv, bottom right uv
+uniform vec4 tile_uv[16];
+
+out vec2 texCoord;
+
+void main() {
+     // Board pixels, origin top left, to normalized device coordinates
+     vec2 position = board_origin + (vec2(cell) + corner) * tile_size;
+     vec2 ndc = position / screen_size * 2.0 - 1.0;
+     gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+
+     vec4 uv = tile_uv[tile];
+     texCoord = mix(uv.xy, uv.zw, corner);
+}
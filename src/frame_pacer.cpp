@@ -0,0 +1,71 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+
+static constexpr f64 min_spin_margin_ms = 0.2;
+static constexpr f64 max_spin_margin_ms = 4.0;
+
+Frame_Pacer::Frame_Pacer(Platform* platform, f64 target_frame_time_ms)
+    : platform(platform),
+      frequency(platform->get_performance_frequency()),
+      period(static_cast<u64>(static_cast<f64>(frequency) *
+                              target_frame_time_ms / 1000.0))
+{
+    reset();
+}
+
+f64 Frame_Pacer::counter_to_ms(u64 count) const
+{
+    return (static_cast<f64>(count) * 1000.0) / static_cast<f64>(frequency);
+}
+
+void Frame_Pacer::reset()
+{
+    deadline = platform->get_performance_counter() + period;
+}
+
+void Frame_Pacer::wait_for_frame_end()
+{
+    u64 now = platform->get_performance_counter();
+
+    // Sleep through the bulk of the remaining time
+    f64 slept_ms = 0.0;
+    while (now < deadline) {
+        const f64 remaining_ms = counter_to_ms(deadline - now);
+        if (remaining_ms <= spin_margin_ms) { break; }
+
+        const f64 request_ms = remaining_ms - spin_margin_ms;
+        platform->sleep_us(static_cast<u64>(request_ms * 1000.0));
+
+        const u64 woke = platform->get_performance_counter();
+        const f64 actual_ms = counter_to_ms(woke - now);
+        const f64 oversleep_ms = actual_ms - request_ms;
+        slept_ms += actual_ms;
+        now = woke;
+
+        // Widen the margin immediately on a late wake, narrow it slowly
+        if (oversleep_ms > spin_margin_ms) {
+            spin_margin_ms = std::min(oversleep_ms * 1.25, max_spin_margin_ms);
+        } else {
+            const f64 settled = spin_margin_ms * 0.99 + oversleep_ms * 0.01;
+            spin_margin_ms = std::max(settled, min_spin_margin_ms);
+        }
+    }
+
+    // Spin out the last fraction of a millisecond
+    const u64 spin_start = now;
+    while (now < deadline) { now = platform->get_performance_counter(); }
+
+    stats.error_ms = static_cast<f32>(
+        (now >= deadline) ? counter_to_ms(now - deadline)
+                          : -counter_to_ms(deadline - now));
+    stats.max_error_ms = std::max(stats.max_error_ms, stats.error_ms);
+    stats.slept_ms = static_cast<f32>(slept_ms);
+    stats.spun_ms = static_cast<f32>(counter_to_ms(now - spin_start));
+    stats.spin_margin_ms = static_cast<f32>(spin_margin_ms);
+
+    // Keep a steady cadence, but don't try to make up for whole frames that
+    // were missed.
+    deadline += period;
+    if (now >= deadline) { deadline = now + period; }
+}
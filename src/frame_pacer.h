@@ -0,0 +1,46 @@
+#pragma once
+
+#include "platform/platform.h"
+#include "types.h"
+
+struct Frame_Pacer_Stats {
+    // Signed difference between when the wait returned and the deadline.
+    // Positive is late.
+    f32 error_ms;
+    f32 max_error_ms;
+    f32 slept_ms;
+    f32 spun_ms;
+    // Time left for spinning after a sleep, adapted to the observed
+    // oversleep of the OS.
+    f32 spin_margin_ms;
+};
+
+/**
+   Holds the frame loop to a fixed frame period without burning a core.
+
+   The pacer sleeps until shortly before the frame deadline, then spins on
+   the performance counter for the remainder. The spin margin tracks how much
+   the OS oversleeps so the spin stays a fraction of a millisecond in the
+   common case.
+ */
+class Frame_Pacer {
+public:
+    Frame_Pacer(Platform* platform, f64 target_frame_time_ms);
+
+    // Start pacing from the current time
+    void reset();
+    // Block until the end of the current frame period
+    void wait_for_frame_end();
+
+    [[nodiscard]] const Frame_Pacer_Stats& get_stats() const { return stats; }
+
+private:
+    Platform* platform;
+    u64 frequency;
+    u64 period;
+    u64 deadline = 0;
+    f64 spin_margin_ms = 0.5;
+    Frame_Pacer_Stats stats = {};
+
+    [[nodiscard]] f64 counter_to_ms(u64 count) const;
+};
@@ -0,0 +1,120 @@
+#include "game/auto_player.h"
+
+#include "perf/profiler.h"
+
+namespace {
+    struct Neighborhood {
+        s32 hidden;
+        s32 flagged;
+    };
+
+    template <typename Fn>
+    void for_each_neighbor(const Grid& board, s32 x, s32 y, Fn&& fn)
+    {
+        for (s32 dy = -1; dy <= 1; ++dy) {
+            for (s32 dx = -1; dx <= 1; ++dx) {
+                const s32 nx = x + dx;
+                const s32 ny = y + dy;
+                if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 ||
+                    nx >= board.width() || ny >= board.length()) {
+                    continue;
+                }
+                fn(nx, ny);
+            }
+        }
+    }
+
+    Neighborhood count_neighbors(const Grid& board, s32 x, s32 y)
+    {
+        Neighborhood n = {0, 0};
+        for_each_neighbor(board, x, y, [&](s32 nx, s32 ny) {
+            switch (board.get_state(nx, ny)) {
+                case Cell_State::hidden: n.hidden++; break;
+                case Cell_State::flagged: n.flagged++; break;
+                case Cell_State::revealed:
+                default: break;
+            }
+        });
+        return n;
+    }
+
+    // One pass of single-cell deductions over the board. Returns the number
+    // of moves made.
+    u32 deduce(Game* game)
+    {
+        const Grid& board = game->board();
+        u32 moves = 0;
+
+        for (s32 y = 0; y < board.length(); ++y) {
+            for (s32 x = 0; x < board.width(); ++x) {
+                if (board.get_state(x, y) != Cell_State::revealed) {
+                    continue;
+                }
+                const char value = board.get(x, y);
+                if (value == 0 || value == mine_val) { continue; }
+
+                const Neighborhood n = count_neighbors(board, x, y);
+                if (n.hidden == 0) { continue; }
+
+                const bool all_flagged = (n.flagged == value);
+                const bool all_mines = (n.flagged + n.hidden == value);
+                if (!all_flagged && !all_mines) { continue; }
+
+                for_each_neighbor(board, x, y, [&](s32 nx, s32 ny) {
+                    if (board.get_state(nx, ny) != Cell_State::hidden) {
+                        return;
+                    }
+                    if (all_flagged) {
+                        game->reveal(nx, ny);
+                    } else {
+                        game->toggle_flag(nx, ny);
+                    }
+                    moves++;
+                });
+
+                if (game->status() != Game_Status::playing) { return moves; }
+            }
+        }
+
+        return moves;
+    }
+
+    void guess(Game* game, std::mt19937& rand_gen)
+    {
+        const Grid& board = game->board();
+        const u32 hidden = board.cell_count() - board.revealed_count() -
+                           board.flagged_count();
+        assert(hidden > 0);
+
+        std::uniform_int_distribution<u32> pick_dis(0, hidden - 1);
+        u32 pick = pick_dis(rand_gen);
+        const u32 width = static_cast<u32>(board.width());
+        for (u32 i = 0; i < board.cell_count(); ++i) {
+            if (board.get_state(i) != Cell_State::hidden) { continue; }
+            if (pick-- == 0) {
+                const s32 x = static_cast<s32>(i % width);
+                const s32 y = static_cast<s32>(i / width);
+                game->reveal(x, y);
+                return;
+            }
+        }
+    }
+} // namespace
+
+u32 play_game(Game* game, std::mt19937& rand_gen)
+{
+    PROFILE_FUNCTION();
+
+    u32 moves = 0;
+    while (game->status() == Game_Status::playing) {
+        const u32 deduced = deduce(game);
+        moves += deduced;
+
+        if (deduced == 0 && game->status() == Game_Status::playing) {
+            guess(game, rand_gen);
+            moves++;
+        }
+    }
+
+    return moves;
+}
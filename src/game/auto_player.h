@@ -0,0 +1,17 @@
+#pragma once
+
+#include "game/game.h"
+#include "types.h"
+#include <random>
+
+/**
+   Play a game to completion with a simple automated player.
+
+   The player applies the single-cell deductions (a number whose flags are
+   all placed reveals its other neighbors; a number with exactly as many
+   hidden neighbors as missing flags flags them all) until they stop making
+   progress, then reveals a random hidden cell.
+
+   \return Number of moves made, where a move is one reveal or flag action.
+ */
+u32 play_game(Game* game, std::mt19937& rand_gen);
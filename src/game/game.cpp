@@ -0,0 +1,162 @@
+#include "game/game.h"
+
+#include "perf/profiler.h"
+#include "platform/hw_counters.h"
+#include <algorithm>
+#include <utility>
+
+Game::Game(Grid board, s32 num_mines, Memory_Arena* storage,
+           Memory_Arena* scratch)
+    : m_board(std::move(board)), m_journal(storage), m_scratch(scratch),
+      m_num_mines(num_mines)
+{
+    assert(num_mines >= 0);
+    assert(scratch != nullptr);
+}
+
+void Game::reveal_cell(u32 i)
+{
+    m_journal.record(i, Cell_State::hidden, Cell_State::revealed);
+    m_board.set_state(i, Cell_State::revealed);
+}
+
+u32 Game::flood_reveal(s32 x, s32 y)
+{
+    // Scanline fill over the zero cells. Each span is revealed left to right
+    // together with its bordering numbers so the journal can record it as a
+    // single run.
+    struct Seed {
+        s32 x;
+        s32 y;
+    };
+
+    const s32 width = m_board.width();
+    const s32 length = m_board.length();
+    const u32 revealed_before = m_board.revealed_count();
+    auto is_hidden_zero = [this](s32 cx, s32 cy) {
+        return m_board.get_state(cx, cy) == Cell_State::hidden &&
+               m_board.get(cx, cy) == 0;
+    };
+
+    Arena_Scope scratch_scope(m_scratch);
+    Arena_Stack<Seed> seeds(m_scratch);
+    seeds.push({x, y});
+
+    while (!seeds.empty()) {
+        const Seed seed = seeds.pop();
+
+        // May have been revealed by another span since it was queued
+        if (!is_hidden_zero(seed.x, seed.y)) { continue; }
+
+        s32 x0 = seed.x;
+        s32 x1 = seed.x;
+        while (x0 > 0 && is_hidden_zero(x0 - 1, seed.y)) { x0--; }
+        while (x1 < width - 1 && is_hidden_zero(x1 + 1, seed.y)) { x1++; }
+
+        // Bordering cells of a zero span are never mines
+        const s32 lo = std::max(x0 - 1, 0);
+        const s32 hi = std::min(x1 + 1, width - 1);
+        for (s32 cx = lo; cx <= hi; ++cx) {
+            if (m_board.get_state(cx, seed.y) == Cell_State::hidden) {
+                reveal_cell(m_board.index(cx, seed.y));
+            }
+        }
+
+        // Rows above and below: queue one seed per zero span, reveal numbers
+        for (s32 cy = seed.y - 1; cy <= seed.y + 1; cy += 2) {
+            if (cy < 0 || cy >= length) { continue; }
+
+            for (s32 cx = lo; cx <= hi; ++cx) {
+                if (m_board.get_state(cx, cy) != Cell_State::hidden) {
+                    continue;
+                }
+
+                if (m_board.get(cx, cy) == 0) {
+                    seeds.push({cx, cy});
+                    while (cx < hi && is_hidden_zero(cx + 1, cy)) { cx++; }
+                } else {
+                    reveal_cell(m_board.index(cx, cy));
+                }
+            }
+        }
+    }
+
+    return m_board.revealed_count() - revealed_before;
+}
+
+static Hw_Counter_Zone reveal_counters("reveal");
+
+u32 Game::reveal(s32 x, s32 y)
+{
+    PROFILE_FUNCTION();
+    if (status() != Game_Status::playing) { return 0; }
+    if (m_board.get_state(x, y) != Cell_State::hidden) { return 0; }
+
+    // Only reveals that do work count as samples
+    Hw_Counter_Scope counters(&reveal_counters);
+
+    u32 revealed = 1;
+    m_journal.begin_action();
+    if (m_board.get(x, y) == 0) {
+        revealed = flood_reveal(x, y);
+    } else {
+        reveal_cell(m_board.index(x, y));
+    }
+    m_journal.end_action();
+
+    m_total_cells_revealed += revealed;
+    counters.add_cells(revealed);
+    return revealed;
+}
+
+bool Game::toggle_flag(s32 x, s32 y)
+{
+    if (status() != Game_Status::playing) { return false; }
+
+    const Cell_State state = m_board.get_state(x, y);
+    if (state == Cell_State::revealed) { return false; }
+
+    const Cell_State new_state = (state == Cell_State::flagged)
+                                     ? Cell_State::hidden
+                                     : Cell_State::flagged;
+    m_journal.begin_action();
+    m_journal.record(m_board.index(x, y), state, new_state);
+    m_board.set_state(x, y, new_state);
+    m_journal.end_action();
+
+    return true;
+}
+
+bool Game::undo()
+{
+    PROFILE_FUNCTION();
+    return m_journal.undo(m_board);
+}
+
+bool Game::redo()
+{
+    PROFILE_FUNCTION();
+    return m_journal.redo(m_board);
+}
+
+bool Game::move_cursor(s32 dx, s32 dy)
+{
+    const s32 x = std::clamp(m_cursor_x + dx, 0, m_board.width() - 1);
+    const s32 y = std::clamp(m_cursor_y + dy, 0, m_board.length() - 1);
+    const bool moved = (x != m_cursor_x) || (y != m_cursor_y);
+
+    m_cursor_x = x;
+    m_cursor_y = y;
+    return moved;
+}
+
+Game_Status Game::status() const
+{
+    if (m_board.mines_revealed() > 0) { return Game_Status::lost; }
+
+    const u32 safe_cells =
+        m_board.cell_count() - static_cast<u32>(m_num_mines);
+    if (m_board.revealed_count() == safe_cells) { return Game_Status::won; }
+
+    return Game_Status::playing;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "game/grid.h"
+#include "game/journal.h"
+#include "memory_arena.h"
+#include "types.h"
+
+enum class Game_Status : u8 { playing, won, lost };
+
+/**
+   A single game of minesweeper: the board, the player's cursor and the
+   undo journal of every action taken.
+
+   The journal grows in the storage arena, which must outlive the game.
+   Temporary work (the flood fill stack) is allocated from the scratch arena
+   and released before each call returns.
+ */
+class Game {
+public:
+    Game(Grid board, s32 num_mines, Memory_Arena* storage,
+         Memory_Arena* scratch);
+    Game(const Game& o) = delete;
+
+    u32 reveal(s32 x, s32 y);
+    bool toggle_flag(s32 x, s32 y);
+    bool undo();
+    bool redo();
+
+    bool move_cursor(s32 dx, s32 dy);
+    // Call once the board changes have been drawn
+    void clear_dirty() { m_board.clear_dirty(); }
+
+    [[nodiscard]] Game_Status status() const;
+    [[nodiscard]] const Grid& board() const { return m_board; }
+    [[nodiscard]] const Journal& journal() const { return m_journal; }
+    [[nodiscard]] s32 cursor_x() const { return m_cursor_x; }
+    [[nodiscard]] s32 cursor_y() const { return m_cursor_y; }
+    // Cells revealed by reveal actions over the whole game, not counting
+    // undo/redo
+    [[nodiscard]] u64 total_cells_revealed() const
+    {
+        return m_total_cells_revealed;
+    }
+
+    Game& operator=(const Game& o) = delete;
+
+private:
+    Grid m_board;
+    Journal m_journal;
+    Memory_Arena* m_scratch;
+    s32 m_num_mines;
+    s32 m_cursor_x = 0;
+    s32 m_cursor_y = 0;
+    u64 m_total_cells_revealed = 0;
+
+    void reveal_cell(u32 i);
+    u32 flood_reveal(s32 x, s32 y);
+};
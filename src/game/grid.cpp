@@ -0,0 +1,199 @@
+#include "game/grid.h"
+
+#include "perf/alloc_tracker.h"
+#include "perf/profiler.h"
+#include "platform/hw_counters.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+Grid::Grid(s32 length, s32 width, Memory_Arena* arena)
+    : m_length(length),
+      m_width(width),
+      m_cell_count(static_cast<u32>(length) * static_cast<u32>(width)),
+      m_board(arena->push_array<char>(m_cell_count)),
+      m_state(arena->push_array<Cell_State>(m_cell_count)),
+      m_chunk_columns((width + grid_chunk_cells - 1) / grid_chunk_cells),
+      m_chunk_count(static_cast<u32>(m_chunk_columns) *
+                    static_cast<u32>((length + grid_chunk_cells - 1) /
+                                     grid_chunk_cells)),
+      m_chunk_dirty(arena->push_array<bool>(m_chunk_count)),
+      m_dirty_chunks(arena->push_array<u32>(m_chunk_count))
+{
+    assert(length > 0);
+    assert(width > 0);
+    assert(static_cast<u64>(length) * static_cast<u64>(width) <=
+           max_board_cells);
+
+    // Arena memory may hold an earlier board
+    std::fill(m_board, m_board + m_cell_count, 0);
+    std::fill(m_state, m_state + m_cell_count, Cell_State::hidden);
+
+    std::fill(m_chunk_dirty, m_chunk_dirty + m_chunk_count, true);
+    for (u32 c = 0; c < m_chunk_count; ++c) { m_dirty_chunks[c] = c; }
+    m_dirty_chunk_count = m_chunk_count;
+}
+
+void Grid::mark_dirty(u32 i)
+{
+    const u32 x = i % static_cast<u32>(m_width);
+    const u32 y = i / static_cast<u32>(m_width);
+    const u32 chunk =
+        (y / grid_chunk_cells) * static_cast<u32>(m_chunk_columns) +
+        x / grid_chunk_cells;
+
+    if (m_chunk_dirty[chunk]) { return; }
+    m_chunk_dirty[chunk] = true;
+    m_dirty_chunks[m_dirty_chunk_count++] = chunk;
+}
+
+void Grid::clear_dirty()
+{
+    // Only the listed chunks are flagged, so this costs what changed
+    for (u32 n = 0; n < m_dirty_chunk_count; ++n) {
+        m_chunk_dirty[m_dirty_chunks[n]] = false;
+    }
+    m_dirty_chunk_count = 0;
+}
+
+Cell_Rect Grid::chunk_rect(u32 chunk) const
+{
+    assert(chunk < m_chunk_count);
+
+    const u32 columns = static_cast<u32>(m_chunk_columns);
+    const s32 x0 = static_cast<s32>(chunk % columns) * grid_chunk_cells;
+    const s32 y0 = static_cast<s32>(chunk / columns) * grid_chunk_cells;
+    return {x0, y0, std::min(x0 + grid_chunk_cells, m_width),
+            std::min(y0 + grid_chunk_cells, m_length)};
+}
+
+void Grid::set_state(u32 i, Cell_State state)
+{
+    assert(i < cell_count());
+
+    const Cell_State old_state = m_state[i];
+    if (old_state == state) { return; }
+
+    switch (old_state) {
+        case Cell_State::revealed: {
+            m_revealed_count--;
+            if (m_board[i] == mine_val) { m_mines_revealed--; }
+        } break;
+        case Cell_State::flagged: m_flagged_count--; break;
+        case Cell_State::hidden:
+        default: break;
+    }
+
+    switch (state) {
+        case Cell_State::revealed: {
+            m_revealed_count++;
+            if (m_board[i] == mine_val) { m_mines_revealed++; }
+        } break;
+        case Cell_State::flagged: m_flagged_count++; break;
+        case Cell_State::hidden:
+        default: break;
+    }
+
+    m_state[i] = state;
+    mark_dirty(i);
+}
+
+void Grid::set_state_run(u32 start, u32 count, Cell_State state)
+{
+    assert(start + count <= cell_count());
+
+    for (u32 i = start; i < start + count; ++i) { set_state(i, state); }
+}
+
+void update_mine_adjacent_counts(Grid& board, s32 x, s32 y)
+{
+    const s32 width = board.width();
+    const s32 length = board.length();
+
+    assert(x >= 0 && x < width);
+    assert(y >= 0 && y < length);
+
+    for (s32 dy = -1; dy <= 1; ++dy) {
+        for (s32 dx = -1; dx <= 1; ++dx) {
+            // Don't update self
+            if (dx == 0 && dy == 0) { continue; }
+
+            const s32 adj_x = x + dx;
+            const s32 adj_y = y + dy;
+
+            // Board bounds check
+            if ((adj_x < 0) || (adj_x >= width) || (adj_y < 0) ||
+                (adj_y >= length)) {
+                continue;
+            }
+
+            // Don't update mine locations
+            if (board.get(adj_x, adj_y) == mine_val) { continue; }
+
+            board.get(adj_x, adj_y)++;
+        }
+    }
+}
+
+static Hw_Counter_Zone gen_board_counters("gen_board");
+
+Grid gen_board(s32 length, s32 width, s32 num_mines, Memory_Arena* arena)
+{
+    std::random_device rd;
+    std::mt19937 rand_gen(rd());
+    return gen_board(length, width, num_mines, rand_gen, arena);
+}
+
+Grid gen_board(s32 length, s32 width, s32 num_mines, std::mt19937& rand_gen,
+               Memory_Arena* arena)
+{
+    PROFILE_FUNCTION();
+    Hw_Counter_Scope counters(&gen_board_counters);
+
+    assert(static_cast<s64>(length) * width >= num_mines);
+
+    Grid board(length, width, arena);
+
+    std::uniform_int_distribution<> length_dis(0, length - 1);
+    std::uniform_int_distribution<> width_dis(0, width - 1);
+
+    for (s32 n = 0; n < num_mines; ++n) {
+        while (true) {
+            const s32 x = width_dis(rand_gen);
+            const s32 y = length_dis(rand_gen);
+
+            if (board.get(x, y) != mine_val) {
+                board.set(x, y, mine_val);
+                update_mine_adjacent_counts(board, x, y);
+                break;
+            }
+        }
+    }
+
+    counters.add_cells(board.cell_count());
+    return board;
+}
+
+void print_board(const Grid& board)
+{
+    ALLOC_TAG(Alloc_Tag::debug);
+    std::string s;
+
+    for (s32 y = 0; y < board.length(); ++y) {
+        for (s32 x = 0; x < board.width(); ++x) {
+            char c;
+            switch (board.get(x, y)) {
+                case 0: c = ' '; break;
+                case mine_val: c = 'X'; break;
+                default: c = static_cast<char>(board.get(x, y) + '0'); break;
+            }
+
+            s += c;
+            s += ' ';
+        }
+
+        s += '\n';
+    }
+
+    printf("%s\n", s.c_str());
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "memory_arena.h"
+#include "types.h"
+#include <cassert>
+#include <limits>
+#include <random>
+
+constexpr char mine_val = std::numeric_limits<char>::max();
+
+// Largest board, 16384x16384 cells or any other shape of the same area.
+// Keeps cell indices well inside u32 and a board, its summary pyramid and
+// journal within the permanent arena.
+constexpr u64 max_board_cells = 1ull << 28;
+
+// Side of the square chunks changes are tracked in. Renderers cache the
+// board in chunks of the same size.
+constexpr s32 grid_chunk_cells = 32;
+
+enum class Cell_State : u8 { hidden = 0, revealed, flagged };
+
+// Cells [x0, x1) x [y0, y1)
+struct Cell_Rect {
+    s32 x0;
+    s32 y0;
+    s32 x1;
+    s32 y1;
+
+    [[nodiscard]] bool empty() const { return x0 >= x1 || y0 >= y1; }
+};
+
+/**
+   Minesweeper board.
+
+   Cells are stored row-major in a single buffer so a cell can be addressed
+   either by (x, y) or by its linear index. The linear index is what the undo
+   journal uses to encode runs of changed cells.
+
+   The cells live in the arena given at construction, which must outlive
+   the grid. Moving a grid hands over the cells; grids are never copied.
+ */
+class Grid {
+private:
+    s32 m_length;
+    s32 m_width;
+    u32 m_cell_count;
+    char* m_board;
+    Cell_State* m_state;
+
+    // Running totals, kept in sync by set_state so they are restored for free
+    // when the journal rewinds cell states.
+    u32 m_revealed_count = 0;
+    u32 m_flagged_count = 0;
+    u32 m_mines_revealed = 0;
+
+    // Chunks with a cell whose state changed since the last clear_dirty(),
+    // each listed once, so renderers update only those chunks however far
+    // apart they are. The flags are per chunk, row-major.
+    s32 m_chunk_columns;
+    u32 m_chunk_count;
+    bool* m_chunk_dirty;
+    u32* m_dirty_chunks;
+    u32 m_dirty_chunk_count = 0;
+
+    void mark_dirty(u32 i);
+
+public:
+    Grid(s32 length, s32 width, Memory_Arena* arena);
+    Grid(const Grid& o) = delete;
+    Grid(Grid&& o) = default;
+
+    [[nodiscard]] s32 length() const { return m_length; }
+    [[nodiscard]] s32 width() const { return m_width; }
+    [[nodiscard]] u32 cell_count() const { return m_cell_count; }
+
+    [[nodiscard]] u32 index(s32 x, s32 y) const
+    {
+        assert(x >= 0 && x < m_width);
+        assert(y >= 0 && y < m_length);
+        return static_cast<u32>(y) * static_cast<u32>(m_width) +
+               static_cast<u32>(x);
+    }
+
+    [[nodiscard]] char get(s32 x, s32 y) const { return m_board[index(x, y)]; }
+    [[nodiscard]] char get(u32 i) const { return m_board[i]; }
+    char& get(s32 x, s32 y) { return m_board[index(x, y)]; }
+    void set(s32 x, s32 y, char val) { m_board[index(x, y)] = val; }
+
+    [[nodiscard]] Cell_State get_state(s32 x, s32 y) const
+    {
+        return m_state[index(x, y)];
+    }
+    [[nodiscard]] Cell_State get_state(u32 i) const { return m_state[i]; }
+    void set_state(s32 x, s32 y, Cell_State state)
+    {
+        set_state(index(x, y), state);
+    }
+    void set_state(u32 i, Cell_State state);
+    void set_state_run(u32 start, u32 count, Cell_State state);
+
+    [[nodiscard]] u32 revealed_count() const { return m_revealed_count; }
+    [[nodiscard]] u32 flagged_count() const { return m_flagged_count; }
+    [[nodiscard]] u32 mines_revealed() const { return m_mines_revealed; }
+
+    [[nodiscard]] s32 chunk_columns() const { return m_chunk_columns; }
+    [[nodiscard]] u32 chunk_count() const { return m_chunk_count; }
+    // Cells of a chunk, clipped to the board
+    [[nodiscard]] Cell_Rect chunk_rect(u32 chunk) const;
+
+    // A new grid starts with every chunk dirty
+    [[nodiscard]] u32 dirty_chunk_count() const { return m_dirty_chunk_count; }
+    [[nodiscard]] u32 dirty_chunk(u32 n) const
+    {
+        assert(n < m_dirty_chunk_count);
+        return m_dirty_chunks[n];
+    }
+    void clear_dirty();
+
+    Grid& operator=(const Grid& o) = delete;
+};
+
+void update_mine_adjacent_counts(Grid& board, s32 x, s32 y);
+Grid gen_board(s32 length, s32 width, s32 num_mines, Memory_Arena* arena);
+Grid gen_board(s32 length, s32 width, s32 num_mines, std::mt19937& rand_gen,
+               Memory_Arena* arena);
+void print_board(const Grid& board);
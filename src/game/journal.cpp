@@ -0,0 +1,102 @@
+#include "game/journal.h"
+
+#include <cassert>
+
+Journal::Journal(Memory_Arena* arena) : m_runs(arena), m_action_begin(arena)
+{}
+
+void Journal::begin_action()
+{
+    assert(!m_recording);
+
+    // A new action invalidates everything that could have been redone
+    if (can_redo()) {
+        m_runs.truncate(m_action_begin[static_cast<u32>(m_cursor)]);
+        m_action_begin.truncate(static_cast<u32>(m_cursor));
+    }
+
+    m_action_begin.push(m_runs.size());
+    m_recording = true;
+}
+
+void Journal::record(u32 index, Cell_State from, Cell_State to)
+{
+    assert(m_recording);
+
+    // Extend the previous run when the cell directly follows it
+    if (m_runs.size() > m_action_begin.back()) {
+        Cell_Run& last = m_runs.back();
+        if (last.from == from && last.to == to &&
+            last.start + last.count == index) {
+            last.count++;
+            return;
+        }
+    }
+
+    m_runs.push({index, 1, from, to});
+}
+
+void Journal::end_action()
+{
+    assert(m_recording);
+    m_recording = false;
+
+    // Don't keep actions that changed nothing
+    if (m_action_begin.back() == m_runs.size()) {
+        m_action_begin.pop();
+        return;
+    }
+
+    m_cursor = m_action_begin.size();
+}
+
+u32 Journal::action_end(std::size_t action) const
+{
+    return (action + 1 < m_action_begin.size())
+               ? m_action_begin[static_cast<u32>(action + 1)]
+               : m_runs.size();
+}
+
+bool Journal::undo(Grid& board)
+{
+    assert(!m_recording);
+    if (!can_undo()) { return false; }
+
+    m_cursor--;
+    const u32 begin = m_action_begin[static_cast<u32>(m_cursor)];
+    for (u32 r = action_end(m_cursor); r > begin; --r) {
+        const Cell_Run& run = m_runs[r - 1];
+        board.set_state_run(run.start, run.count, run.from);
+    }
+
+    return true;
+}
+
+bool Journal::redo(Grid& board)
+{
+    assert(!m_recording);
+    if (!can_redo()) { return false; }
+
+    const u32 end = action_end(m_cursor);
+    for (u32 r = m_action_begin[static_cast<u32>(m_cursor)]; r < end; ++r) {
+        const Cell_Run& run = m_runs[r];
+        board.set_state_run(run.start, run.count, run.to);
+    }
+    m_cursor++;
+
+    return true;
+}
+
+std::size_t Journal::memory_usage() const
+{
+    return m_runs.get_capacity() * sizeof(Cell_Run) +
+           m_action_begin.get_capacity() * sizeof(u32);
+}
+
+void Journal::clear()
+{
+    assert(!m_recording);
+    m_runs.clear();
+    m_action_begin.clear();
+    m_cursor = 0;
+}
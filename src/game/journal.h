@@ -0,0 +1,63 @@
+#pragma once
+
+#include "game/grid.h"
+#include "memory_arena.h"
+#include "types.h"
+#include <cstddef>
+
+/**
+   Contiguous cells (by linear grid index) that all made the same state
+   transition within one action.
+ */
+struct Cell_Run {
+    u32 start;
+    u32 count;
+    Cell_State from;
+    Cell_State to;
+};
+
+/**
+   Undo/redo journal of game actions.
+
+   Only the cells an action changed are recorded, as runs over the grid's
+   linear index. A cascading reveal touches whole row spans at a time, so a
+   large opening collapses to roughly one run per row it covers. Undo and redo
+   replay the runs of a single action, so their cost is proportional to the
+   number of cells the action changed.
+
+   All actions share one run buffer; an action is the range of runs starting
+   at its entry in action_begin. Both live in the arena given at
+   construction, which must outlive the journal.
+ */
+class Journal {
+public:
+    explicit Journal(Memory_Arena* arena);
+    Journal(const Journal& o) = delete;
+
+    void begin_action();
+    void record(u32 index, Cell_State from, Cell_State to);
+    void end_action();
+
+    bool undo(Grid& board);
+    bool redo(Grid& board);
+
+    [[nodiscard]] bool can_undo() const { return m_cursor > 0; }
+    [[nodiscard]] bool can_redo() const
+    {
+        return m_cursor < m_action_begin.size();
+    }
+    [[nodiscard]] std::size_t memory_usage() const;
+    void clear();
+
+    Journal& operator=(const Journal& o) = delete;
+
+private:
+    Arena_Stack<Cell_Run> m_runs;
+    Arena_Stack<u32> m_action_begin;
+    // Number of actions currently applied. Actions at or past the cursor are
+    // available to redo.
+    std::size_t m_cursor = 0;
+    bool m_recording = false;
+
+    [[nodiscard]] u32 action_end(std::size_t action) const;
+};
@@ -15,12 +15,23 @@ struct Game_Input_Button {
 
 struct Game_Input_Controller {
     union {
-        Game_Input_Button buttons[4];
+        Game_Input_Button buttons[14];
         struct {
             Game_Input_Button up;
             Game_Input_Button down;
             Game_Input_Button left;
             Game_Input_Button right;
+            Game_Input_Button reveal;
+            Game_Input_Button flag;
+            Game_Input_Button undo;
+            Game_Input_Button redo;
+            // Camera
+            Game_Input_Button pan_up;
+            Game_Input_Button pan_down;
+            Game_Input_Button pan_left;
+            Game_Input_Button pan_right;
+            Game_Input_Button zoom_in;
+            Game_Input_Button zoom_out;
         };
     };
 };
@@ -32,9 +43,22 @@ static_assert(offsetof(Game_Input_Controller, buttons[0]) == offsetof(Game_Input
               "Alignment of controller input union does not match.");
 */
 
+// True if the button went down at any point since the last input poll
+inline bool was_pressed(const Game_Input_Button& button)
+{
+    return (button.half_transitions > 1) ||
+           (button.half_transitions == 1 && button.ended_down);
+}
+
 struct Game_State {
     bool request_quit;
     bool toggle_pause;
+    bool toggle_overlay;
+    // The window contents were lost or resized and must be drawn again
+    bool request_redraw;
+    // Minimized or otherwise not visible. Nothing needs to be drawn and the
+    // game is paused until it is shown again.
+    bool window_hidden;
 };
 
 struct Game_Input {
@@ -0,0 +1,153 @@
+#include "job_system.h"
+
+#include "perf/profiler.h"
+#include <cassert>
+#include <utility>
+
+namespace {
+    // Pool and index of the worker running on this thread, if any
+    thread_local const Job_System* current_pool = nullptr;
+    thread_local u32 current_index = 0;
+} // namespace
+
+Job_System::Job_System(u32 worker_count)
+    : queues(), workers(), sleep_mutex(), wake()
+{
+    for (u32 i = 0; i < worker_count + 1; ++i) {
+        queues.push_back(std::make_unique<Job_Queue>());
+    }
+
+    workers.reserve(worker_count);
+    for (u32 i = 0; i < worker_count; ++i) {
+        workers.emplace_back(&Job_System::worker_main, this, i);
+    }
+}
+
+Job_System::~Job_System()
+{
+    // Run what is still queued here too, so a pool without workers still
+    // finishes its jobs. Workers keep draining until the queues are empty.
+    const u32 self = current_thread_index();
+    Job job;
+    while (find_job(self, &job)) { execute(&job); }
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stop = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& worker : workers) { worker.join(); }
+    assert(queued.load() == 0);
+}
+
+u32 Job_System::current_thread_index() const
+{
+    return (current_pool == this) ? current_index : get_worker_count();
+}
+
+void Job_System::run(Task_Group* group, Job_Fn fn)
+{
+    group->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job_Queue& queue = *queues[current_thread_index()];
+    {
+        // Count the job before it can be popped, or a thief's decrement
+        // could run first and wrap the counter
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queued.fetch_add(1, std::memory_order_release);
+        queue.jobs.push_back({std::move(fn), group});
+    }
+
+    // Taking the lock orders this notify after a sleeping worker's predicate
+    // check, so the wakeup can't be lost.
+    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+    wake.notify_one();
+}
+
+bool Job_System::pop_back(u32 queue_index, Job* job)
+{
+    Job_Queue& queue = *queues[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) { return false; }
+
+    *job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Job_System::pop_front(u32 queue_index, Job* job)
+{
+    Job_Queue& queue = *queues[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) { return false; }
+
+    *job = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Job_System::find_job(u32 self, Job* job)
+{
+    if (queued.load(std::memory_order_acquire) == 0) { return false; }
+
+    const u32 injector = get_worker_count();
+    const u32 queue_count = static_cast<u32>(queues.size());
+
+    // Own work first, newest first
+    if (self != injector && pop_back(self, job)) { return true; }
+    if (pop_front(injector, job)) { return true; }
+
+    // Steal the oldest job of another worker
+    for (u32 i = 1; i < queue_count; ++i) {
+        const u32 victim = (self + i) % queue_count;
+        if (victim != injector && pop_front(victim, job)) { return true; }
+    }
+
+    return false;
+}
+
+void Job_System::execute(Job* job)
+{
+    job->fn();
+    job->group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void Job_System::wait(Task_Group* group)
+{
+    PROFILE_FUNCTION();
+
+    const u32 self = current_thread_index();
+    while (!group->is_done()) {
+        Job job;
+        if (find_job(self, &job)) {
+            execute(&job);
+        } else {
+            // Remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Job_System::worker_main(u32 index)
+{
+    PROFILE_THREAD_NAME("job_worker");
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        Job job;
+        if (find_job(index, &job)) {
+            execute(&job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] {
+            return stop || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stop && queued.load(std::memory_order_acquire) == 0) { break; }
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "types.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+   Set of jobs that can be waited on together. A job may add more jobs to
+   its own group; wait() covers those too.
+ */
+class Task_Group {
+public:
+    Task_Group() = default;
+    Task_Group(const Task_Group& o) = delete;
+
+    [[nodiscard]] bool is_done() const
+    {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+    Task_Group& operator=(const Task_Group& o) = delete;
+
+private:
+    friend class Job_System;
+    std::atomic<u32> pending{0};
+};
+
+/**
+   Work-stealing thread pool.
+
+   Each worker owns a deque: it pushes and pops its own jobs at the back
+   (newest first, for cache locality) while idle workers steal from the front
+   (oldest first, which tend to be the largest pieces of work). Jobs submitted
+   from outside the pool go to a shared injection queue.
+
+   wait() does not return until every job of the group has finished, and the
+   waiting thread executes queued jobs rather than sleeping, so a frame loop
+   can fork work and join it within the frame. Destruction finishes all
+   queued jobs before joining the workers.
+ */
+class Job_System {
+public:
+    using Job_Fn = std::function<void()>;
+
+    // A worker count of 0 runs every job on the thread that waits for it
+    explicit Job_System(u32 worker_count);
+    Job_System(const Job_System& o) = delete;
+    ~Job_System();
+
+    void run(Task_Group* group, Job_Fn fn);
+    void wait(Task_Group* group);
+
+    // Call fn(chunk_begin, chunk_end) over [begin, end) in chunks of at most
+    // grain, in parallel, and wait for all of them.
+    template <typename Fn>
+    void parallel_for(u32 begin, u32 end, u32 grain, Fn&& fn);
+
+    [[nodiscard]] u32 get_worker_count() const
+    {
+        return static_cast<u32>(workers.size());
+    }
+    // Index of the calling worker in [0, worker count), or the worker count
+    // for threads outside the pool. Useful for per-thread scratch data.
+    [[nodiscard]] u32 current_thread_index() const;
+
+    Job_System& operator=(const Job_System& o) = delete;
+
+private:
+    struct Job {
+        Job_Fn fn{};
+        Task_Group* group = nullptr;
+    };
+
+    struct alignas(64) Job_Queue {
+        std::mutex mutex{};
+        std::deque<Job> jobs{};
+    };
+
+    // One queue per worker, followed by the injection queue
+    std::vector<std::unique_ptr<Job_Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<u32> queued{0};
+    bool stop = false;
+
+    bool pop_back(u32 queue, Job* job);
+    bool pop_front(u32 queue, Job* job);
+    bool find_job(u32 self, Job* job);
+    void execute(Job* job);
+    void worker_main(u32 index);
+};
+
+template <typename Fn>
+void Job_System::parallel_for(u32 begin, u32 end, u32 grain, Fn&& fn)
+{
+    grain = std::max(grain, 1u);
+
+    Task_Group group;
+    for (u32 chunk_begin = begin; chunk_begin < end;) {
+        const u32 chunk_end =
+            (end - chunk_begin > grain) ? chunk_begin + grain : end;
+        run(&group, [&fn, chunk_begin, chunk_end] {
+            fn(chunk_begin, chunk_end);
+        });
+        chunk_begin = chunk_end;
+    }
+    wait(&group);
+}
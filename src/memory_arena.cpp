@@ -0,0 +1,74 @@
+#include "memory_arena.h"
+
+#include "platform/platform.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+Memory_Arena::Memory_Arena(std::size_t capacity)
+    : base(static_cast<u8*>(Platform::platform_alloc(capacity))),
+      capacity(capacity)
+{
+    if (base == nullptr) { throw std::bad_alloc(); }
+}
+
+Memory_Arena::~Memory_Arena()
+{
+    Platform::platform_free(base, capacity);
+}
+
+void* Memory_Arena::push(std::size_t size, std::size_t align)
+{
+    assert(align != 0 && (align & (align - 1)) == 0);
+
+    const std::uintptr_t address =
+        reinterpret_cast<std::uintptr_t>(base) + used;
+    const std::size_t padding = (align - (address & (align - 1))) & (align - 1);
+    if (padding + size > capacity - used) {
+        printf("Memory arena exhausted: %zu of %zu bytes used, %zu requested\n",
+               used, capacity, size);
+        throw std::bad_alloc();
+    }
+
+    if (!commit_to(used + padding + size)) { throw std::bad_alloc(); }
+
+    void* p = base + used + padding;
+    used += padding + size;
+    high_water = std::max(high_water, used);
+    return p;
+}
+
+bool Memory_Arena::extend(void* p, std::size_t old_size, std::size_t new_size)
+{
+    if (static_cast<u8*>(p) + old_size != base + used) { return false; }
+    if (new_size - old_size > capacity - used) { return false; }
+    if (!commit_to(used + new_size - old_size)) { return false; }
+
+    used += new_size - old_size;
+    high_water = std::max(high_water, used);
+    return true;
+}
+
+bool Memory_Arena::commit_to(std::size_t end)
+{
+    if (end <= committed) { return true; }
+
+    // Committed pages stay committed across resets; the next frame reuses them
+    const std::size_t rounded =
+        (end + commit_granularity - 1) / commit_granularity *
+        commit_granularity;
+    const std::size_t new_committed = std::min(rounded, capacity);
+    if (!Platform::platform_commit(base + committed,
+                                   new_committed - committed)) {
+        return false;
+    }
+    committed = new_committed;
+    return true;
+}
+
+void Memory_Arena::reset_to_mark(std::size_t mark)
+{
+    assert(mark <= used);
+    used = mark;
+}
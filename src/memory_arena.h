@@ -0,0 +1,136 @@
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+   Linear (bump) allocator over one block of address space.
+
+   Allocation is a pointer bump and there is no per-allocation free: memory
+   is released all at once with reset(), or back to an earlier mark. The
+   block is reserved from the platform up front and committed in chunks as
+   the arena first grows into them, so reserving generously is cheap.
+
+   Running out of space throws std::bad_alloc, the same as operator new.
+ */
+class Memory_Arena {
+public:
+    explicit Memory_Arena(std::size_t capacity);
+    Memory_Arena(const Memory_Arena& o) = delete;
+    ~Memory_Arena();
+
+    void* push(std::size_t size,
+               std::size_t align = alignof(std::max_align_t));
+    // Uninitialized array; only for types that need no destructor
+    template <typename T>
+    T* push_array(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena memory is released without running destructors");
+        return static_cast<T*>(push(sizeof(T) * count, alignof(T)));
+    }
+    // Grow the most recent allocation in place. Returns false if p is not the
+    // most recent allocation or the arena is out of space.
+    bool extend(void* p, std::size_t old_size, std::size_t new_size);
+
+    void reset() { used = 0; }
+    [[nodiscard]] std::size_t get_mark() const { return used; }
+    void reset_to_mark(std::size_t mark);
+
+    [[nodiscard]] std::size_t get_used() const { return used; }
+    [[nodiscard]] std::size_t get_capacity() const { return capacity; }
+    [[nodiscard]] std::size_t get_high_water() const { return high_water; }
+
+    Memory_Arena& operator=(const Memory_Arena& o) = delete;
+
+private:
+    static constexpr std::size_t commit_granularity = 64 * 1024;
+
+    u8* base = nullptr;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    std::size_t high_water = 0;
+    std::size_t committed = 0;
+
+    bool commit_to(std::size_t end);
+};
+
+/**
+   Returns the arena to its position at construction when the scope ends,
+   freeing everything allocated in between.
+ */
+class Arena_Scope {
+public:
+    explicit Arena_Scope(Memory_Arena* arena)
+        : arena(arena), mark(arena->get_mark())
+    {}
+    Arena_Scope(const Arena_Scope& o) = delete;
+    ~Arena_Scope() { arena->reset_to_mark(mark); }
+
+    Arena_Scope& operator=(const Arena_Scope& o) = delete;
+
+private:
+    Memory_Arena* arena;
+    std::size_t mark;
+};
+
+/**
+   Growable stack of trivially copyable values in an arena. Grows in place
+   while it is the newest allocation, otherwise moves to a block twice the
+   size; the old block is reclaimed with the arena.
+ */
+template <typename T>
+class Arena_Stack {
+public:
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Arena_Stack moves elements with memcpy");
+
+    explicit Arena_Stack(Memory_Arena* arena, u32 initial_capacity = 64)
+        : arena(arena), items(arena->push_array<T>(initial_capacity)),
+          capacity(initial_capacity)
+    {}
+    Arena_Stack(const Arena_Stack& o) = delete;
+
+    void push(const T& value)
+    {
+        if (count == capacity) { grow(); }
+        items[count++] = value;
+    }
+    T pop() { return items[--count]; }
+    // Drop everything past the first new_size values, keeping the capacity
+    void truncate(u32 new_size)
+    {
+        if (new_size < count) { count = new_size; }
+    }
+    void clear() { count = 0; }
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] u32 size() const { return count; }
+    [[nodiscard]] u32 get_capacity() const { return capacity; }
+    [[nodiscard]] T& operator[](u32 i) { return items[i]; }
+    [[nodiscard]] const T& operator[](u32 i) const { return items[i]; }
+    [[nodiscard]] T& back() { return items[count - 1]; }
+    [[nodiscard]] const T& back() const { return items[count - 1]; }
+
+    Arena_Stack& operator=(const Arena_Stack& o) = delete;
+
+private:
+    Memory_Arena* arena;
+    T* items;
+    u32 count = 0;
+    u32 capacity;
+
+    void grow()
+    {
+        const u32 new_capacity = capacity * 2;
+        if (!arena->extend(items, sizeof(T) * capacity,
+                           sizeof(T) * new_capacity)) {
+            T* new_items = arena->push_array<T>(new_capacity);
+            std::memcpy(new_items, items, sizeof(T) * count);
+            items = new_items;
+        }
+        capacity = new_capacity;
+    }
+};
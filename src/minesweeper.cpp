@@ -1,219 +1,491 @@
+#include "frame_pacer.h"
+#include "game/game.h"
+#include "game/grid.h"
 #include "input.h"
+#include "perf/alloc_tracker.h"
+#include "perf/frame_stats.h"
+#include "perf/profiler.h"
+#include "perf/telemetry.h"
+#include "platform/headless.h"
+#include "platform/hw_counters.h"
 #include "platform/platform.h"
 #include "platform/sdl2.h"
+#include "renderer/camera.h"
+#include "renderer/null_renderer.h"
 #include "renderer/opengl.h"
+#include "renderer/perf_overlay.h"
+#include "simulate.h"
 #include "types.h"
-#include <cassert>
+#include <algorithm>
 #include <cstdio>
-#include <limits>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
-#include <random>
-#include <string>
-#include <vector>
 
-constexpr char mine_val = std::numeric_limits<char>::max();
-
-class Grid {
-private:
-    std::vector<std::vector<char>> m_board;
+/**
+   \return True if anything visible changed.
+ */
+bool update(Game* game, const Game_Input* input)
+{
+    PROFILE_FUNCTION();
+    ALLOC_TAG(Alloc_Tag::update);
 
-public:
-    Grid(s32 length, s32 width)
-        : m_board(static_cast<u32>(length),
-                  std::vector<char>(static_cast<u32>(width)))
-    {
-        assert(length > 0);
-        assert(width > 0);
-    }
+    const Game_Input_Controller& keyboard =
+        input->controllers[Controller::keyboard];
+    bool changed = false;
 
-    [[nodiscard]] s32 length() const
-    {
-        return static_cast<s32>(m_board.size());
-    }
-    [[nodiscard]] s32 width() const
-    {
-        return static_cast<s32>(m_board[0].size());
-    }
+    if (was_pressed(keyboard.up)) { changed |= game->move_cursor(0, -1); }
+    if (was_pressed(keyboard.down)) { changed |= game->move_cursor(0, 1); }
+    if (was_pressed(keyboard.left)) { changed |= game->move_cursor(-1, 0); }
+    if (was_pressed(keyboard.right)) { changed |= game->move_cursor(1, 0); }
 
-    [[nodiscard]] char get(s32 x, s32 y) const
-    {
-        assert(x >= 0);
-        assert(y >= 0);
-        return m_board[static_cast<u32>(y)][static_cast<u32>(x)];
+    if (was_pressed(keyboard.reveal)) {
+        changed |= game->reveal(game->cursor_x(), game->cursor_y()) > 0;
     }
-    char& get(s32 x, s32 y)
-    {
-        assert(x >= 0);
-        assert(y >= 0);
-        return m_board[static_cast<u32>(y)][static_cast<u32>(x)];
+    if (was_pressed(keyboard.flag)) {
+        changed |= game->toggle_flag(game->cursor_x(), game->cursor_y());
     }
-    void set(s32 x, s32 y, char val)
-    {
-        assert(x >= 0);
-        assert(y >= 0);
-        m_board[static_cast<u32>(y)][static_cast<u32>(x)] = val;
-    }
-};
-
-void update_mine_adjacent_counts(Grid& board, s32 x, s32 y)
-{
-    const s32 width = board.width();
-    const s32 length = board.length();
-
-    assert(x >= 0 && x < width);
-    assert(y >= 0 && y < length);
+    if (was_pressed(keyboard.undo)) { changed |= game->undo(); }
+    if (was_pressed(keyboard.redo)) { changed |= game->redo(); }
 
-    for (s32 dy = -1; dy <= 1; ++dy) {
-        for (s32 dx = -1; dx <= 1; ++dx) {
-            // Don't update self
-            if (dx == 0 && dy == 0) { continue; }
-
-            const s32 adj_x = x + dx;
-            const s32 adj_y = y + dy;
-
-            // Board bounds check
-            if ((adj_x < 0) || (adj_x >= width) || (adj_y < 0) ||
-                (adj_y >= length)) {
-                continue;
-            }
-
-            // Don't update mine locations
-            if (board.get(adj_x, adj_y) == mine_val) { continue; }
-
-            board.get(adj_x, adj_y)++;
-        }
-    }
+    return changed;
 }
 
-Grid gen_board(s32 length, s32 width, s32 num_mines)
-{
-    assert(length * width >= num_mines);
-
-    Grid board(length, width);
+/**
+   Pan and zoom the view. Unlike update() this works while paused.
 
-    std::random_device rd;
-    std::mt19937 rand_gen(rd());
-    std::uniform_int_distribution<> length_dis(0, length - 1);
-    std::uniform_int_distribution<> width_dis(0, width - 1);
-
-    for (s32 n = 0; n < num_mines; ++n) {
-        while (true) {
-            const s32 x = width_dis(rand_gen);
-            const s32 y = length_dis(rand_gen);
+   \return True if the view changed.
+ */
+bool update_camera(Camera* camera, const Grid& board, const Game_Input* input)
+{
+    const Game_Input_Controller& keyboard =
+        input->controllers[Controller::keyboard];
+    bool changed = false;
 
-            if (board.get(x, y) != mine_val) {
-                board.set(x, y, mine_val);
-                update_mine_adjacent_counts(board, x, y);
-                break;
-            }
-        }
+    if (was_pressed(keyboard.pan_up)) {
+        changed |= pan_camera(camera, board, 0, -1);
     }
+    if (was_pressed(keyboard.pan_down)) {
+        changed |= pan_camera(camera, board, 0, 1);
+    }
+    if (was_pressed(keyboard.pan_left)) {
+        changed |= pan_camera(camera, board, -1, 0);
+    }
+    if (was_pressed(keyboard.pan_right)) {
+        changed |= pan_camera(camera, board, 1, 0);
+    }
+    if (was_pressed(keyboard.zoom_in)) { changed |= zoom_camera(camera, 1); }
+    if (was_pressed(keyboard.zoom_out)) { changed |= zoom_camera(camera, -1); }
 
-    return board;
+    return changed;
 }
 
-void print_board(const Grid& board)
+/**
+   \param frame_arena Holds the frame's draw items; reset after the frame.
+   \param overlay Performance overlay to draw on top, or null.
+   \param alpha Fraction of a simulation tick that has elapsed since the last
+   update, for interpolating between the previous and current game state.
+ */
+void render(Renderer* renderer, Memory_Arena* frame_arena, const Game& game,
+            const Camera& camera, const Perf_Overlay* overlay,
+            [[maybe_unused]] f32 alpha)
 {
-    std::string s;
-
-    for (s32 y = 0; y < board.length(); ++y) {
-        for (s32 x = 0; x < board.width(); ++x) {
-            char c;
-            switch (board.get(x, y)) {
-                case 0: c = ' '; break;
-                case mine_val: c = 'X'; break;
-                default: c = static_cast<char>(board.get(x, y) + '0'); break;
-            }
-
-            s += c;
-            s += ' ';
-        }
-
-        s += '\n';
+    PROFILE_FUNCTION();
+    ALLOC_TAG(Alloc_Tag::render);
+
+    Render_Command_Buffer commands(frame_arena);
+    commands.push_board(0, &game.board(), game.cursor_x(), game.cursor_y(),
+                        camera);
+    // Only needed once part of the board is out of view
+    if (camera.zoom > camera_min_zoom) {
+        commands.push_minimap(Render_Layer::overlay, 0, &game.board(), camera);
+    }
+    if (overlay != nullptr) {
+        commands.push_quads(Render_Layer::overlay, 0, overlay->get_vertices(),
+                            overlay->get_vertex_count());
     }
 
-    printf("%s\n", s.c_str());
+    renderer->clear_screen();
+    renderer->execute(commands);
 }
 
-void update(const Game_Input*)
+static f64 counter_to_ms(u64 count, u64 frequency)
 {
-    // TODO(stewarts):
+    return (static_cast<f64>(count) * 1000.0) / static_cast<f64>(frequency);
 }
 
-void render(Renderer* renderer)
+static u64 counter_to_us(u64 count, u64 frequency)
 {
-    // TODO(stewarts):
-    renderer->proto_draw();
-    renderer->swap_buffer();
+    return static_cast<u64>((static_cast<f64>(count) * 1000000.0) /
+                            static_cast<f64>(frequency));
 }
 
-static constexpr s32 board_length = 40;
-static constexpr s32 board_width = 80;
+static constexpr s32 default_board_length = 40;
+static constexpr s32 default_board_width = 80;
 static constexpr f64 mine_percent = 0.1;
-static constexpr s32 num_mines =
-    static_cast<s32>(board_length * board_width * mine_percent);
 
-int main(int, char*[])
+int main(int argc, char* argv[])
 {
-    Grid board = gen_board(board_length, board_width, num_mines);
-    // print_board(board);
+    // Render only when something changed, sleeping in the platform layer in
+    // between. Continuous rendering redraws every frame regardless.
+    bool on_demand_rendering = true;
+    // Periodically print frame time percentiles, and once more at exit
+    bool perf_report = false;
+    // Binary per-frame metrics file, see tools/telemetry_to_csv.cpp
+    char const* telemetry_path = nullptr;
+    // Chrome trace of the profiling zones, written at exit. Requires a build
+    // with ENABLE_PROFILING.
+    char const* trace_path = nullptr;
+    // Hardware counters (IPC, cache and branch misses) of board generation
+    // and reveal, printed at exit. Linux only.
+    bool hw_counters = false;
+    // Run without a display, reading input from a script. Frames are
+    // unpaced and each advances the simulation by exactly one tick, so the
+    // run measures simulation throughput.
+    bool headless = false;
+    char const* input_script_path = nullptr;
+    // Report frames with more heap allocations than this. Requires a build
+    // with ENABLE_ALLOC_TRACKING.
+    bool alloc_budget = false;
+    // Board dimensions as WIDTHxLENGTH cells
+    s32 board_length = default_board_length;
+    s32 board_width = default_board_width;
+    Board_Draw_Mode board_draw_mode = Board_Draw_Mode::automatic;
+    // Batch mode: auto-play games on every core and report throughput
+    bool simulate = false;
+    Simulation_Config simulation = {0, 0, 0, 100000, 0, 0};
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--continuous-rendering") == 0) {
+            on_demand_rendering = false;
+        } else if (std::strcmp(argv[i], "--perf-report") == 0) {
+            perf_report = true;
+        } else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--profile-trace") == 0 &&
+                   i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--hw-counters") == 0) {
+            hw_counters = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+            on_demand_rendering = false;
+        } else if (std::strcmp(argv[i], "--input-script") == 0 &&
+                   i + 1 < argc) {
+            input_script_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--alloc-budget") == 0 &&
+                   i + 1 < argc) {
+            alloc_budget = true;
+            alloc_tracking_set_frame_budget(
+                static_cast<u32>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--board-size") == 0 &&
+                   i + 1 < argc) {
+            s32 w = 0;
+            s32 l = 0;
+            // Tile instances address cells with u16 coordinates
+            if (std::sscanf(argv[++i], "%dx%d", &w, &l) == 2 && w > 0 &&
+                l > 0 && w <= 0xffff && l <= 0xffff &&
+                static_cast<u64>(w) * static_cast<u64>(l) <= max_board_cells) {
+                board_width = w;
+                board_length = l;
+            } else {
+                printf("Invalid board size '%s' (at most 65535 per side and "
+                       "%llu cells)\n",
+                       argv[i],
+                       static_cast<unsigned long long>(max_board_cells));
+            }
+        } else if (std::strcmp(argv[i], "--board-draw-mode") == 0 &&
+                   i + 1 < argc) {
+            ++i;
+            if (std::strcmp(argv[i], "instanced") == 0) {
+                board_draw_mode = Board_Draw_Mode::instanced;
+            } else if (std::strcmp(argv[i], "texture") == 0) {
+                board_draw_mode = Board_Draw_Mode::texture;
+            }
+        } else if (std::strcmp(argv[i], "--simulate") == 0) {
+            simulate = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                simulation.games = std::strtoull(argv[++i], nullptr, 10);
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            simulation.threads =
+                static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            simulation.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+
+    const s32 num_mines = static_cast<s32>(
+        static_cast<f64>(board_length) * static_cast<f64>(board_width) *
+        mine_percent);
+    simulation.board_length = board_length;
+    simulation.board_width = board_width;
+    simulation.num_mines = num_mines;
+
+    PROFILE_THREAD_NAME("main");
+    if (hw_counters && !hw_counters_enable()) {
+        printf("Hardware performance counters unavailable\n");
+        hw_counters = false;
+    }
+
+    if (alloc_budget && !alloc_tracking_available()) {
+        printf("Allocation tracking unavailable (built without "
+               "ENABLE_ALLOC_TRACKING?)\n");
+        alloc_budget = false;
+    }
 
-    std::unique_ptr<Platform> platform = std::make_unique<Sdl2>();
-    std::unique_ptr<Renderer> renderer =
-        std::make_unique<OpenGl>("Minesweeper", platform.get());
+    if (simulate) {
+        print_simulation_result(run_simulation(simulation));
+        if (hw_counters) { hw_counters_report(); }
+        if (trace_path != nullptr && !profiler_write_chrome_trace(trace_path)) {
+            printf("Profile trace not written (built without "
+                   "ENABLE_PROFILING?)\n");
+        }
+        return 0;
+    }
+
+    std::unique_ptr<Platform> platform;
+    std::unique_ptr<Renderer> renderer;
+    if (headless) {
+        platform = std::make_unique<Headless>(input_script_path);
+        renderer = std::make_unique<Null_Renderer>();
+    } else {
+        platform = std::make_unique<Sdl2>();
+        renderer = std::make_unique<OpenGl>("Minesweeper", platform.get());
+    }
+    renderer->set_board_draw_mode(board_draw_mode);
     bool running = true;
     bool pause = false;
 
+    Memory_Arena* frame_arena = platform->get_frame_arena();
+    Memory_Arena* permanent_arena = platform->get_permanent_arena();
+    Game game(gen_board(board_length, board_width, num_mines, permanent_arena),
+              num_mines, permanent_arena, frame_arena);
+    Camera camera = make_camera(game.board());
+    // print_board(game.board());
+
     // Performance stats
     u64 perf_start_frame;
     u64 perf_sys_count;
     f32 perf_sys_time_ms;
     u64 perf_end_frame;
-    s32 perf_fps;
     u64 perf_frequency = platform->get_performance_frequency();
+    Frame_Stats frame_stats;
+    Perf_Overlay perf_overlay;
+    bool show_perf_overlay = false;
+    f32 last_frame_time_ms = 0.0f;
+    u64 perf_frame_index = 0;
+    u64 perf_update_count = 0;
+    u64 perf_cells_revealed = 0;
+    std::unique_ptr<Telemetry_Sink> telemetry;
+    if (telemetry_path != nullptr) {
+        telemetry = std::make_unique<Telemetry_Sink>(telemetry_path);
+    }
+    constexpr f64 perf_report_interval_ms = 10000.0;
+    u64 perf_last_report = platform->get_performance_counter();
 
     constexpr f32 target_fps = 60.0f;
     constexpr f32 target_frame_time_ms = 1000.0f / target_fps;
 
+    // Simulation runs at a fixed tick rate, independent of the frame rate.
+    // Elapsed frame time is banked in the accumulator and spent in whole
+    // ticks; the remainder becomes the render interpolation alpha.
+    constexpr f64 update_hz = 120.0;
+    constexpr f64 tick_time_ms = 1000.0 / update_hz;
+    // Bound the catch-up work after a stall (debugger, window drag, etc.) so
+    // a long frame can't snowball into ever longer frames.
+    constexpr f64 max_frame_time_ms = 250.0;
+    constexpr s32 max_ticks_per_frame = 8;
+    f64 accumulator_ms = 0.0;
+
+    // Longest the idle loop blocks without any system event
+    constexpr u32 idle_timeout_ms = 1000;
+    bool redraw = true;
+
+    // Apply one poll worth of input. Returns true if a redraw is needed.
+    auto process_input = [&](Game_Input const* input) {
+        running = !input->state.request_quit;
+        if (!running) { return false; }
+
+        bool changed = input->state.request_redraw;
+        if (input->state.toggle_overlay) {
+            show_perf_overlay = !show_perf_overlay;
+            changed = true;
+        }
+        if (input->state.toggle_pause) {
+            pause = !pause;
+            changed = true;
+        }
+        if (!input->state.window_hidden) {
+            changed |= update_camera(&camera, game.board(), input);
+        }
+        if (!pause && !input->state.window_hidden) {
+            const u64 update_start = platform->get_performance_counter();
+            changed |= update(&game, input);
+            const u64 update_count =
+                platform->get_performance_counter() - update_start;
+            frame_stats.update_us.record(
+                counter_to_us(update_count, perf_frequency));
+            perf_update_count += update_count;
+        }
+
+        return changed;
+    };
+
     // Init
     platform->set_process_to_high_priority();
-    renderer->proto_setup();
+    renderer->load_assets();
 
+    Frame_Pacer pacer(platform.get(), target_frame_time_ms);
+    perf_start_frame = platform->get_performance_counter();
     while (running) {
-        perf_start_frame = platform->get_performance_counter();
+        PROFILE_ZONE("frame");
+
+        // Nothing allocated from the frame arena outlives the frame that
+        // allocated it
+        frame_arena->reset();
+        Alloc_Frame_Scope alloc_frame(alloc_budget, perf_frame_index);
+
+        bool window_hidden = platform->get_input()->state.window_hidden;
+        if (window_hidden || (on_demand_rendering && !redraw)) {
+            // Idle: either nothing can be seen or the last presented frame is
+            // still current, so block until the OS hands us something to react
+            // to. Restoring the window is such an event.
+            bool woken = false;
+            {
+                ALLOC_TAG(Alloc_Tag::platform);
+                woken = platform->wait_sys_event_queue(idle_timeout_ms);
+            }
+            if (woken) {
+                redraw |= process_input(platform->get_input());
+                if (!running) { break; }
+            }
 
-        render(renderer.get());
+            // Time spent blocked is not simulation time to catch up on
+            accumulator_ms = 0.0;
+            pacer.reset();
+            perf_start_frame = platform->get_performance_counter();
 
-        f32 frame_time_ms = 0.0f;
-        do {
-            // Collect system event information
-            platform->process_sys_event_queue();
-            Game_Input const* input = platform->get_input();
-            running = !input->state.request_quit;
-            if (!running) { break; }
+            window_hidden = platform->get_input()->state.window_hidden;
+            if (window_hidden || !redraw) { continue; }
+        }
 
-            if (input->state.toggle_pause) { pause = !pause; }
-            if (pause) { continue; }
+        // Simulate
+        //
+        s32 ticks = 0;
+        while (accumulator_ms >= tick_time_ms) {
+            if (ticks == max_ticks_per_frame) {
+                accumulator_ms = 0.0;
+                break;
+            }
 
-            update(input);
+            // Collect system event information. Polled per tick so each
+            // input transition is seen by exactly one update.
+            {
+                ALLOC_TAG(Alloc_Tag::platform);
+                platform->process_sys_event_queue();
+            }
+            redraw |= process_input(platform->get_input());
+            if (!running) { break; }
 
-            frame_time_ms = static_cast<f32>(
-                (static_cast<f64>(platform->get_performance_counter() -
-                                  perf_start_frame) *
-                 1000.0) /
-                static_cast<f64>(perf_frequency));
-            // printf("STEWART: frame time of target - %fms/%fms\n",
-            // frame_time_ms, target_frame_time_ms);
-        } while (frame_time_ms < target_frame_time_ms);
+            accumulator_ms -= tick_time_ms;
+            ticks++;
+        }
+        if (!running) { break; }
+
+        // Went hidden mid-frame: skip drawing, the next iteration idles
+        if (platform->get_input()->state.window_hidden) { continue; }
+
+        // Render
+        //
+        const u64 render_start = platform->get_performance_counter();
+        if (show_perf_overlay) {
+            ALLOC_TAG(Alloc_Tag::perf);
+            Perf_Overlay_Data data = {};
+            data.frame_time_ms = last_frame_time_ms;
+            data.p99_frame_time_ms =
+                static_cast<f32>(frame_stats.frame_us.percentile(99.0)) /
+                1000.0f;
+            data.target_frame_time_ms = target_frame_time_ms;
+            const Render_Stats& render_stats = renderer->get_stats();
+            data.draw_calls = render_stats.draw_calls;
+            data.state_changes = render_stats.state_changes;
+            data.state_changes_elided = render_stats.state_changes_elided;
+            data.peak_memory_bytes = platform->get_peak_memory_usage();
+            perf_overlay.build(data, frame_arena);
+        }
+        render(renderer.get(), frame_arena, game, camera,
+               show_perf_overlay ? &perf_overlay : nullptr,
+               static_cast<f32>(accumulator_ms / tick_time_ms));
+        const u64 swap_start = platform->get_performance_counter();
+        {
+            ALLOC_TAG(Alloc_Tag::render);
+            renderer->swap_buffer();
+        }
+        const u64 swap_end = platform->get_performance_counter();
+        frame_stats.render_us.record(
+            counter_to_us(swap_end - render_start, perf_frequency));
+        game.clear_dirty();
+        redraw = false;
+
+        // Wait out the rest of the frame
+        //
+        {
+            PROFILE_ZONE("wait_for_frame_end");
+            if (!headless) { pacer.wait_for_frame_end(); }
+        }
 
         perf_end_frame = platform->get_performance_counter();
         perf_sys_count = perf_end_frame - perf_start_frame;
         perf_sys_time_ms =
-            static_cast<f32>((static_cast<f64>(perf_sys_count) * 1000.0) /
-                             static_cast<f64>(perf_frequency));
-        perf_fps = static_cast<s32>(1 / (perf_sys_time_ms / 1000));
+            static_cast<f32>(counter_to_ms(perf_sys_count, perf_frequency));
         perf_start_frame = perf_end_frame;
-        printf("frame: %fms (%d fps)\n", perf_sys_time_ms, perf_fps);
+        frame_stats.frame_us.record(
+            counter_to_us(perf_sys_count, perf_frequency));
+        frame_stats.max_pacing_error_ms = std::max(
+            frame_stats.max_pacing_error_ms, pacer.get_stats().error_ms);
+        last_frame_time_ms = perf_sys_time_ms;
+        perf_overlay.push_frame_time(perf_sys_time_ms);
+
+        if (telemetry) {
+            ALLOC_TAG(Alloc_Tag::perf);
+            Telemetry_Record record = {};
+            record.frame_index = perf_frame_index;
+            record.frame_time_us = static_cast<u32>(
+                counter_to_us(perf_sys_count, perf_frequency));
+            record.update_time_us = static_cast<u32>(
+                counter_to_us(perf_update_count, perf_frequency));
+            record.render_time_us = static_cast<u32>(
+                counter_to_us(swap_start - render_start, perf_frequency));
+            record.swap_time_us = static_cast<u32>(
+                counter_to_us(swap_end - swap_start, perf_frequency));
+            record.cells_revealed = static_cast<u32>(
+                game.total_cells_revealed() - perf_cells_revealed);
+            record.draw_calls = renderer->get_stats().draw_calls;
+            telemetry->push(record);
+        }
+        perf_frame_index++;
+        perf_update_count = 0;
+        perf_cells_revealed = game.total_cells_revealed();
+
+        if (perf_report &&
+            counter_to_ms(perf_end_frame - perf_last_report, perf_frequency) >=
+                perf_report_interval_ms) {
+            frame_stats.report();
+            frame_stats.reset();
+            perf_last_report = perf_end_frame;
+        }
+
+        accumulator_ms +=
+            headless ? tick_time_ms
+                     : std::min(static_cast<f64>(perf_sys_time_ms),
+                                max_frame_time_ms);
+    }
+
+    if (perf_report) { frame_stats.report(); }
+    if (hw_counters) { hw_counters_report(); }
+    if (alloc_budget) { alloc_tracking_report(); }
+    if (trace_path != nullptr && !profiler_write_chrome_trace(trace_path)) {
+        printf("Profile trace not written (built without ENABLE_PROFILING?)\n");
     }
 
     return 0;
@@ -0,0 +1,229 @@
+#include "perf/alloc_tracker.h"
+
+#if defined(ENABLE_ALLOC_TRACKING)
+
+#    include <atomic>
+#    include <cstdio>
+#    include <cstdlib>
+#    include <new>
+
+namespace {
+    constexpr std::size_t tag_count =
+        static_cast<std::size_t>(Alloc_Tag::count);
+
+    constexpr char const* tag_names[tag_count] = {
+        "untagged", "platform", "update", "render", "perf", "debug"};
+
+    struct Tag_Counters {
+        std::atomic<u64> allocations{0};
+        std::atomic<u64> bytes{0};
+        std::atomic<u64> frees{0};
+    };
+
+    // Counters since the start of the current frame, and since startup.
+    // Constant initialized, so allocations made before main are counted too.
+    Tag_Counters frame_counters[tag_count];
+    Tag_Counters total_counters[tag_count];
+
+    thread_local Alloc_Tag current_tag = Alloc_Tag::untagged;
+
+    u32 frame_budget = 0;
+    u64 frames_over_budget = 0;
+
+    void count_allocation(std::size_t size)
+    {
+        const std::size_t tag = static_cast<std::size_t>(current_tag);
+        frame_counters[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+        frame_counters[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+        total_counters[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+        total_counters[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void count_free(void* p)
+    {
+        if (p == nullptr) { return; }
+
+        const std::size_t tag = static_cast<std::size_t>(current_tag);
+        frame_counters[tag].frees.fetch_add(1, std::memory_order_relaxed);
+        total_counters[tag].frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* tracked_alloc(std::size_t size)
+    {
+        count_allocation(size);
+        // malloc(0) may return null, which new must not
+        return std::malloc((size == 0) ? 1 : size);
+    }
+
+    void* tracked_aligned_alloc(std::size_t size, std::size_t align)
+    {
+        count_allocation(size);
+#    if defined(_WIN32)
+        return _aligned_malloc((size == 0) ? 1 : size, align);
+#    else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t rounded = ((size + align - 1) / align) * align;
+        return std::aligned_alloc(align, (rounded == 0) ? align : rounded);
+#    endif
+    }
+
+    void tracked_free(void* p)
+    {
+        count_free(p);
+        std::free(p);
+    }
+
+    void tracked_aligned_free(void* p)
+    {
+        count_free(p);
+#    if defined(_WIN32)
+        _aligned_free(p);
+#    else
+        std::free(p);
+#    endif
+    }
+
+    void print_counters(const Tag_Counters* counters)
+    {
+        for (std::size_t t = 0; t < tag_count; ++t) {
+            const u64 allocations =
+                counters[t].allocations.load(std::memory_order_relaxed);
+            const u64 frees = counters[t].frees.load(std::memory_order_relaxed);
+            if (allocations == 0 && frees == 0) { continue; }
+
+            printf("  %-9s %8llu allocs %10llu bytes %8llu frees\n",
+                   tag_names[t], static_cast<unsigned long long>(allocations),
+                   static_cast<unsigned long long>(
+                       counters[t].bytes.load(std::memory_order_relaxed)),
+                   static_cast<unsigned long long>(frees));
+        }
+    }
+} // namespace
+
+Alloc_Tag_Scope::Alloc_Tag_Scope(Alloc_Tag tag) : previous(current_tag)
+{
+    current_tag = tag;
+}
+
+Alloc_Tag_Scope::~Alloc_Tag_Scope() { current_tag = previous; }
+
+bool alloc_tracking_available() { return true; }
+
+void alloc_tracking_set_frame_budget(u32 max_allocations)
+{
+    frame_budget = max_allocations;
+}
+
+void alloc_tracking_begin_frame()
+{
+    for (Tag_Counters& counters : frame_counters) {
+        counters.allocations.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+        counters.frees.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool alloc_tracking_end_frame(u64 frame_index)
+{
+    u64 allocations = 0;
+    u64 bytes = 0;
+    for (const Tag_Counters& counters : frame_counters) {
+        allocations += counters.allocations.load(std::memory_order_relaxed);
+        bytes += counters.bytes.load(std::memory_order_relaxed);
+    }
+    if (allocations <= frame_budget) { return true; }
+
+    frames_over_budget++;
+    printf("frame %llu: %llu heap allocations (%llu bytes), budget %u\n",
+           static_cast<unsigned long long>(frame_index),
+           static_cast<unsigned long long>(allocations),
+           static_cast<unsigned long long>(bytes), frame_budget);
+    print_counters(frame_counters);
+    return false;
+}
+
+void alloc_tracking_report()
+{
+    printf("heap allocations since startup, %llu frames over budget:\n",
+           static_cast<unsigned long long>(frames_over_budget));
+    print_counters(total_counters);
+}
+
+// Replacement global allocation functions. The array, nothrow and sized
+// forms are all routed here so no allocation bypasses the counters.
+
+void* operator new(std::size_t size)
+{
+    void* p = tracked_alloc(size);
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return tracked_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return tracked_alloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    void* p = tracked_aligned_alloc(size, static_cast<std::size_t>(align));
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+void operator delete(void* p) noexcept { tracked_free(p); }
+void operator delete[](void* p) noexcept { tracked_free(p); }
+void operator delete(void* p, std::size_t) noexcept { tracked_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { tracked_free(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    tracked_aligned_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    tracked_aligned_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    tracked_aligned_free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    tracked_aligned_free(p);
+}
+
+#else
+
+bool alloc_tracking_available() { return false; }
+void alloc_tracking_set_frame_budget(u32) {}
+void alloc_tracking_begin_frame() {}
+bool alloc_tracking_end_frame(u64) { return true; }
+void alloc_tracking_report() {}
+
+#endif
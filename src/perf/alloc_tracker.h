@@ -0,0 +1,90 @@
+#pragma once
+
+#include "types.h"
+
+/**
+   Global heap allocation tracking.
+
+   With ENABLE_ALLOC_TRACKING defined (cmake -DENABLE_ALLOC_TRACKING=ON) the
+   global operator new/delete are replaced with counting versions. Every
+   allocation is charged to the subsystem tag of the allocating thread, set
+   with ALLOC_TAG(tag) for the enclosing scope. The frame loop brackets each
+   frame with alloc_tracking_begin_frame()/alloc_tracking_end_frame(), and
+   frames that go over the per-frame budget are reported with a breakdown
+   by tag. Frees are charged to the tag of the freeing thread.
+
+   Without the define the macros compile away and the functions do nothing.
+ */
+
+enum class Alloc_Tag : u8 {
+    untagged,
+    platform,
+    update,
+    render,
+    perf,
+    debug,
+
+    count
+};
+
+#if defined(ENABLE_ALLOC_TRACKING)
+
+#    define ALLOC_TAG_CONCAT_IMPL(a, b) a##b
+#    define ALLOC_TAG_CONCAT(a, b) ALLOC_TAG_CONCAT_IMPL(a, b)
+#    define ALLOC_TAG(tag) \
+        Alloc_Tag_Scope ALLOC_TAG_CONCAT(alloc_tag_, __LINE__)(tag)
+
+class Alloc_Tag_Scope {
+public:
+    explicit Alloc_Tag_Scope(Alloc_Tag tag);
+    Alloc_Tag_Scope(const Alloc_Tag_Scope& o) = delete;
+    ~Alloc_Tag_Scope();
+
+    Alloc_Tag_Scope& operator=(const Alloc_Tag_Scope& o) = delete;
+
+private:
+    Alloc_Tag previous;
+};
+
+#else
+
+#    define ALLOC_TAG(tag)
+
+#endif
+
+// False if tracking is compiled out
+bool alloc_tracking_available();
+// Allocations per frame above which a frame is reported. The default of 0
+// reports any frame that touches the heap.
+void alloc_tracking_set_frame_budget(u32 max_allocations);
+void alloc_tracking_begin_frame();
+// Returns false and prints the frame's allocations by tag if it went over
+// budget.
+bool alloc_tracking_end_frame(u64 frame_index);
+// Totals since startup, and the number of frames over budget
+void alloc_tracking_report();
+
+/**
+   Brackets one frame loop iteration with alloc_tracking_begin_frame() and
+   alloc_tracking_end_frame(), so iterations that leave early through
+   continue or break are still checked against the budget.
+ */
+class Alloc_Frame_Scope {
+public:
+    Alloc_Frame_Scope(bool enabled, u64 frame_index)
+        : enabled(enabled), frame_index(frame_index)
+    {
+        if (enabled) { alloc_tracking_begin_frame(); }
+    }
+    Alloc_Frame_Scope(const Alloc_Frame_Scope& o) = delete;
+    ~Alloc_Frame_Scope()
+    {
+        if (enabled) { alloc_tracking_end_frame(frame_index); }
+    }
+
+    Alloc_Frame_Scope& operator=(const Alloc_Frame_Scope& o) = delete;
+
+private:
+    bool enabled;
+    u64 frame_index;
+};
@@ -0,0 +1,32 @@
+#include "perf/frame_stats.h"
+
+#include <cstdio>
+
+static void report_histogram(char const* name, const Histogram& histogram)
+{
+    auto ms = [](u64 us) { return static_cast<f64>(us) / 1000.0; };
+
+    printf("%-7s n=%-7llu p50 %7.3fms  p90 %7.3fms  p99 %7.3fms  "
+           "p99.9 %7.3fms  max %7.3fms\n",
+           name, static_cast<unsigned long long>(histogram.get_count()),
+           ms(histogram.percentile(50.0)), ms(histogram.percentile(90.0)),
+           ms(histogram.percentile(99.0)), ms(histogram.percentile(99.9)),
+           ms(histogram.get_max()));
+}
+
+void Frame_Stats::report() const
+{
+    report_histogram("frame", frame_us);
+    report_histogram("update", update_us);
+    report_histogram("render", render_us);
+    printf("pacing  max error %+.3fms\n",
+           static_cast<f64>(max_pacing_error_ms));
+}
+
+void Frame_Stats::reset()
+{
+    frame_us.reset();
+    update_us.reset();
+    render_us.reset();
+    max_pacing_error_ms = 0.0f;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "perf/histogram.h"
+#include "types.h"
+
+/**
+   Distribution of the main loop timings, in microseconds.
+
+   Recording only touches the in-memory histograms; formatting and printing
+   happen in report(), which the caller runs at its own cadence.
+ */
+struct Frame_Stats {
+    Histogram frame_us{};
+    Histogram update_us{};
+    Histogram render_us{};
+    // Worst frame pacer deadline miss since the last reset
+    f32 max_pacing_error_ms = 0.0f;
+
+    void report() const;
+    void reset();
+};
@@ -0,0 +1,83 @@
+#include "perf/histogram.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+static u32 most_significant_bit(u64 value)
+{
+    assert(value != 0);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<u32>(index);
+#else
+    return 63u - static_cast<u32>(__builtin_clzll(value));
+#endif
+}
+
+// ~0ull has its top bit at 63, so it lands in the last sub bucket of shift
+// 63 - sub_bucket_bits
+static_assert((63 - Histogram::sub_bucket_bits) * Histogram::sub_bucket_count +
+                      (2 * Histogram::sub_bucket_count - 1) ==
+                  Histogram::bucket_count - 1,
+              "Histogram must have a bucket for every u64 value");
+
+u32 Histogram::bucket_index(u64 value)
+{
+    // Linear range
+    if (value < 2 * sub_bucket_count) { return static_cast<u32>(value); }
+
+    // Log range: keep the top sub_bucket_bits + 1 bits of the value
+    const u32 shift = most_significant_bit(value) - sub_bucket_bits;
+    const u64 mantissa = value >> shift; // [sub_bucket_count, 2 * ...)
+    return shift * sub_bucket_count + static_cast<u32>(mantissa);
+}
+
+u64 Histogram::bucket_highest_value(u32 index)
+{
+    if (index < 2 * sub_bucket_count) { return index; }
+
+    const u32 shift = index / sub_bucket_count - 1;
+    const u64 mantissa = index - shift * sub_bucket_count;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void Histogram::record(u64 value)
+{
+    const u32 index = bucket_index(value);
+    assert(index < bucket_count);
+    buckets[index]++;
+    count++;
+    total += value;
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+void Histogram::reset() { *this = Histogram(); }
+
+u64 Histogram::percentile(f64 percent) const
+{
+    if (count == 0) { return 0; }
+
+    const f64 clamped = std::clamp(percent, 0.0, 100.0);
+    const u64 target = std::max<u64>(
+        1, static_cast<u64>(clamped / 100.0 * static_cast<f64>(count) + 0.5));
+
+    u64 seen = 0;
+    for (u32 i = 0; i < bucket_count; ++i) {
+        seen += buckets[i];
+        if (seen >= target) { return std::min(bucket_highest_value(i), max); }
+    }
+
+    return max;
+}
+
+f64 Histogram::get_mean() const
+{
+    return (count > 0) ? static_cast<f64>(total) / static_cast<f64>(count)
+                       : 0.0;
+}
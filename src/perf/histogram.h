@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.h"
+#include <array>
+
+/**
+   Fixed-size log-linear histogram in the style of HdrHistogram.
+
+   Values below 2 * sub_bucket_count are counted exactly. Above that each
+   power of two is split into sub_bucket_count equal buckets, giving a
+   relative error of at most 1 / sub_bucket_count over the whole u64 range.
+   Recording is a handful of integer ops and never allocates, so it is safe
+   to call every frame.
+ */
+class Histogram {
+public:
+    static constexpr u32 sub_bucket_bits = 5;
+    static constexpr u32 sub_bucket_count = 1u << sub_bucket_bits;
+    static constexpr u32 bucket_count =
+        (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    void record(u64 value);
+    void reset();
+
+    // Smallest recorded value v such that at least `percent` of all recorded
+    // values are <= v, to within the bucket precision.
+    [[nodiscard]] u64 percentile(f64 percent) const;
+    [[nodiscard]] u64 get_count() const { return count; }
+    [[nodiscard]] u64 get_min() const { return (count > 0) ? min : 0; }
+    [[nodiscard]] u64 get_max() const { return max; }
+    [[nodiscard]] f64 get_mean() const;
+
+private:
+    std::array<u32, bucket_count> buckets = {};
+    u64 count = 0;
+    u64 total = 0;
+    u64 min = ~0ull;
+    u64 max = 0;
+
+    static u32 bucket_index(u64 value);
+    static u64 bucket_highest_value(u32 index);
+};
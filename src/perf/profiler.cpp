@@ -0,0 +1,137 @@
+#include "perf/profiler.h"
+
+#if defined(ENABLE_PROFILING)
+
+#    include <atomic>
+#    include <chrono>
+#    include <cstdio>
+#    include <memory>
+#    include <mutex>
+#    include <vector>
+
+namespace {
+    struct Zone_Event {
+        char const* name;
+        u64 start_ns;
+        u64 end_ns;
+    };
+
+    /**
+       Ring of the latest zones recorded by one thread. Only the owning
+       thread writes; once full the oldest zones are overwritten, so a long
+       session keeps its most recent capacity zones.
+     */
+    struct Thread_Buffer {
+        // Fixed capacity so recording never reallocates under a reader
+        static constexpr std::size_t capacity = 1 << 18;
+
+        std::unique_ptr<Zone_Event[]> events{new Zone_Event[capacity]};
+        // Total zones ever recorded; the ring slot is written % capacity
+        std::atomic<u64> written{0};
+        u32 thread_id = 0;
+        char const* thread_name = nullptr;
+    };
+
+    std::mutex registry_mutex;
+    std::vector<std::unique_ptr<Thread_Buffer>> registry;
+
+    const auto epoch = std::chrono::steady_clock::now();
+
+    u64 now_ns()
+    {
+        return static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epoch)
+                .count());
+    }
+
+    Thread_Buffer* thread_buffer()
+    {
+        // Buffers are owned by the registry so they outlive their thread and
+        // can still be exported after it exits.
+        thread_local Thread_Buffer* buffer = [] {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            registry.push_back(std::make_unique<Thread_Buffer>());
+            registry.back()->thread_id = static_cast<u32>(registry.size());
+            return registry.back().get();
+        }();
+        return buffer;
+    }
+} // namespace
+
+Profile_Zone::Profile_Zone(char const* name) : name(name), start_ns(now_ns())
+{}
+
+Profile_Zone::~Profile_Zone()
+{
+    const u64 end_ns = now_ns();
+    Thread_Buffer* buffer = thread_buffer();
+
+    const u64 i = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[i % Thread_Buffer::capacity] = {name, start_ns, end_ns};
+    buffer->written.store(i + 1, std::memory_order_release);
+}
+
+void profiler_set_thread_name(char const* name)
+{
+    thread_buffer()->thread_name = name;
+}
+
+bool profiler_write_chrome_trace(char const* file_path)
+{
+    FILE* file = fopen(file_path, "w");
+    if (file == nullptr) {
+        printf("Unable to open trace file '%s'\n", file_path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto& buffer : registry) {
+        if (buffer->thread_name != nullptr) {
+            fprintf(file,
+                    "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                    "\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", buffer->thread_id,
+                    buffer->thread_name);
+            first = false;
+        }
+
+        // Oldest surviving zone first
+        const u64 written = buffer->written.load(std::memory_order_acquire);
+        const u64 begin = (written > Thread_Buffer::capacity)
+                              ? written - Thread_Buffer::capacity
+                              : 0;
+        for (u64 i = begin; i < written; ++i) {
+            const Zone_Event& e = buffer->events[i % Thread_Buffer::capacity];
+            // Complete events; timestamps in microseconds
+            fprintf(file,
+                    "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                    "\"ts\":%.3f,\"dur\":%.3f}",
+                    first ? "" : ",\n", e.name, buffer->thread_id,
+                    static_cast<f64>(e.start_ns) / 1000.0,
+                    static_cast<f64>(e.end_ns - e.start_ns) / 1000.0);
+            first = false;
+        }
+
+        if (begin > 0) {
+            printf("Profiler kept the last %llu zones on thread %u, "
+                   "%llu older zones were overwritten\n",
+                   static_cast<unsigned long long>(written - begin),
+                   buffer->thread_id, static_cast<unsigned long long>(begin));
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    const bool ok = (ferror(file) == 0);
+    fclose(file);
+    return ok;
+}
+
+#else
+
+bool profiler_write_chrome_trace(char const*) { return false; }
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "types.h"
+
+/**
+   Scoped zone profiler with Chrome trace export.
+
+   PROFILE_ZONE("name") times the enclosing scope. Zones nest naturally and
+   each thread records into its own ring buffer, so recording takes no locks.
+   Once a ring is full the oldest zones are overwritten, so a long session
+   keeps its most recent zones. The result is written as Chrome trace event
+   JSON, viewable in chrome://tracing or Perfetto.
+
+   Everything compiles away unless ENABLE_PROFILING is defined (cmake
+   -DENABLE_PROFILING=ON). Zone names must be string literals or otherwise
+   outlive the profiler, since only the pointer is stored.
+ */
+
+#if defined(ENABLE_PROFILING)
+
+#    define PROFILE_CONCAT_IMPL(a, b) a##b
+#    define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#    define PROFILE_ZONE(name) \
+        Profile_Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#    define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#    define PROFILE_THREAD_NAME(name) profiler_set_thread_name(name)
+
+class Profile_Zone {
+public:
+    explicit Profile_Zone(char const* name);
+    Profile_Zone(const Profile_Zone& o) = delete;
+    ~Profile_Zone();
+
+    Profile_Zone& operator=(const Profile_Zone& o) = delete;
+
+private:
+    char const* name;
+    u64 start_ns;
+};
+
+void profiler_set_thread_name(char const* name);
+
+#else
+
+#    define PROFILE_ZONE(name)
+#    define PROFILE_FUNCTION()
+#    define PROFILE_THREAD_NAME(name)
+
+#endif
+
+// Write the retained zones of all threads as Chrome trace JSON. Call when
+// instrumented threads are quiescent. Returns false if profiling is compiled
+// out or the file could not be written.
+bool profiler_write_chrome_trace(char const* file_path);
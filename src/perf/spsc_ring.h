@@ -0,0 +1,72 @@
+#pragma once
+
+#include "types.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/**
+   Bounded lock-free single-producer/single-consumer ring buffer.
+
+   One thread may push and one other thread may pop, concurrently, without
+   locks. Head and tail live on separate cache lines and each side keeps a
+   cached copy of the other side's index, so the shared lines are only
+   touched when the cached view says the ring looks full (or empty).
+ */
+template <typename T, std::size_t Capacity>
+class Spsc_Ring {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "elements are copied as raw values");
+
+public:
+    // Producer only. Returns false if the ring is full.
+    bool try_push(const T& value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == Capacity) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == Capacity) { return false; }
+        }
+
+        m_slots[tail & mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Pops up to max_count values into out, returning how many
+    // were popped.
+    std::size_t pop_batch(T* out, std::size_t max_count)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_tail_cache == head) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (m_tail_cache == head) { return 0; }
+        }
+
+        std::size_t count = m_tail_cache - head;
+        if (count > max_count) { count = max_count; }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = m_slots[(head + i) & mask];
+        }
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+    static constexpr std::size_t cache_line_size = 64;
+
+    // Consumer side
+    alignas(cache_line_size) std::atomic<std::size_t> m_head{0};
+    std::size_t m_tail_cache = 0;
+
+    // Producer side
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_head_cache = 0;
+
+    alignas(cache_line_size) std::array<T, Capacity> m_slots{};
+};
@@ -0,0 +1,75 @@
+#include "perf/telemetry.h"
+
+#include "perf/profiler.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+Telemetry_Sink::Telemetry_Sink(char const* file_path)
+{
+    file = fopen(file_path, "wb");
+    if (file == nullptr) {
+        printf("Unable to open telemetry file '%s': %s\n", file_path,
+               strerror(errno));
+        return;
+    }
+
+    Telemetry_File_Header header = {};
+    std::memcpy(header.magic, telemetry_magic, sizeof(header.magic));
+    header.version = telemetry_version;
+    header.record_size = sizeof(Telemetry_Record);
+    fwrite(&header, sizeof(header), 1, file);
+
+    writer = std::thread(&Telemetry_Sink::writer_main, this);
+}
+
+Telemetry_Sink::~Telemetry_Sink()
+{
+    if (file == nullptr) { return; }
+
+    stop.store(true, std::memory_order_release);
+    writer.join();
+    fclose(file);
+
+    if (dropped > 0) {
+        printf("Telemetry dropped %llu records\n",
+               static_cast<unsigned long long>(dropped));
+    }
+}
+
+void Telemetry_Sink::push(const Telemetry_Record& record)
+{
+    if (file == nullptr) { return; }
+    if (!ring.try_push(record)) { dropped++; }
+}
+
+std::size_t Telemetry_Sink::drain(Telemetry_Record* batch)
+{
+    std::size_t total = 0;
+    std::size_t count;
+    while ((count = ring.pop_batch(batch, batch_size)) > 0) {
+        PROFILE_ZONE("telemetry_write");
+        fwrite(batch, sizeof(Telemetry_Record), count, file);
+        total += count;
+    }
+    return total;
+}
+
+void Telemetry_Sink::writer_main()
+{
+    PROFILE_THREAD_NAME("telemetry_writer");
+    Telemetry_Record batch[batch_size];
+
+    // The producer never signals, so poll every 20 ms. The ring holds
+    // ring_capacity frames, over a minute at 60 fps, so records are only
+    // dropped when an unpaced loop outruns the poll interval.
+    while (!stop.load(std::memory_order_acquire)) {
+        if (drain(batch) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    // Producer has stopped; flush whatever is left
+    drain(batch);
+    fflush(file);
+}
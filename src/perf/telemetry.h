@@ -0,0 +1,72 @@
+#pragma once
+
+#include "perf/spsc_ring.h"
+#include "types.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+/**
+   One frame of metrics, written to the telemetry file as raw bytes.
+
+   Keep the layout fixed-size and append-only: the file header carries the
+   record size, and readers zero-fill the fields an older, shorter record
+   lacks.
+ */
+struct Telemetry_Record {
+    u64 frame_index;
+    u32 frame_time_us;
+    u32 update_time_us;
+    u32 render_time_us;
+    u32 swap_time_us;
+    u32 cells_revealed;
+    u32 draw_calls;
+};
+static_assert(sizeof(Telemetry_Record) == 32,
+              "telemetry record layout is part of the file format");
+
+struct Telemetry_File_Header {
+    char magic[4]; // "MSTL"
+    u32 version;
+    u32 record_size;
+    u32 reserved;
+};
+
+constexpr char telemetry_magic[4] = {'M', 'S', 'T', 'L'};
+constexpr u32 telemetry_version = 1;
+
+/**
+   Persists telemetry records without blocking the frame loop on file I/O.
+
+   The frame loop pushes records into a lock-free ring. A background writer
+   thread drains the ring and writes to disk in batches. If the writer falls
+   behind and the ring fills, records are dropped and counted rather than
+   stalling the producer.
+ */
+class Telemetry_Sink {
+public:
+    explicit Telemetry_Sink(char const* file_path);
+    Telemetry_Sink(const Telemetry_Sink& o) = delete;
+    ~Telemetry_Sink();
+
+    // Producer side, called from the frame loop
+    void push(const Telemetry_Record& record);
+
+    [[nodiscard]] bool is_open() const { return file != nullptr; }
+    [[nodiscard]] u64 get_dropped_count() const { return dropped; }
+
+    Telemetry_Sink& operator=(const Telemetry_Sink& o) = delete;
+
+private:
+    static constexpr std::size_t ring_capacity = 4096;
+    static constexpr std::size_t batch_size = 256;
+
+    FILE* file = nullptr;
+    Spsc_Ring<Telemetry_Record, ring_capacity> ring{};
+    std::atomic<bool> stop{false};
+    std::thread writer{};
+    u64 dropped = 0;
+
+    void writer_main();
+    std::size_t drain(Telemetry_Record* batch);
+};
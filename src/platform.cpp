@@ -1,13 +1,21 @@
 #include "platform/platform.h"
 
 #if defined(__linux__)
+#    include <sys/mman.h>
 #    include <sys/resource.h>
+#    include <time.h>
 #    include <cerrno>
 #    include <cstring>
 #elif defined(_WIN32)
 #    include <Windows.h>
+#    include <psapi.h>
 #    include <strsafe.h>
+#    include <timeapi.h>
 #    include <cstring>
+// Windows 10 1803 and later; older SDKs lack the name
+#    ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#        define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#    endif
 #endif
 
 void Platform::set_process_to_high_priority() const
@@ -51,6 +59,123 @@ void Platform::set_process_to_high_priority() const
 #endif
 }
 
+void Platform::sleep_us(u64 microseconds) const
+{
+#if defined(__linux__)
+    timespec request = {};
+    request.tv_sec = static_cast<time_t>(microseconds / 1000000);
+    request.tv_nsec = static_cast<long>((microseconds % 1000000) * 1000);
+
+    // Resume after signal interruptions with the time that was left
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR) {
+    }
+
+#elif defined(_WIN32)
+    // NOTE(sdsmith): Sleep granularity is the system timer resolution
+    // (15.6ms by default). A high resolution waitable timer wakes within
+    // about half a millisecond without changing the system-wide resolution.
+    thread_local HANDLE timer = CreateWaitableTimerExW(
+        nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+        TIMER_ALL_ACCESS);
+    if (timer != nullptr) {
+        // Relative due time in 100ns units
+        LARGE_INTEGER due = {};
+        due.QuadPart = -static_cast<LONGLONG>(microseconds * 10);
+        if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(timer, INFINITE);
+            return;
+        }
+    }
+
+    // Older Windows: raise the timer resolution for the duration of the sleep
+    timeBeginPeriod(1);
+    Sleep(static_cast<DWORD>((microseconds + 999) / 1000));
+    timeEndPeriod(1);
+#else
+#    error Platform not supported.
+#endif
+}
+
+u64 Platform::get_peak_memory_usage() const
+{
+#if defined(__linux__)
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) < 0) { return 0; }
+    // NOTE(sdsmith): ru_maxrss is in kilobytes on Linux
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                                 sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<u64>(counters.PeakWorkingSetSize);
+#else
+#    error Platform not supported.
+#endif
+}
+
+void* Platform::platform_alloc(std::size_t size)
+{
+#if defined(__linux__)
+    // NOTE(sdsmith): MAP_NORESERVE only reserves address space; pages are
+    // backed on first touch.
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        printf("Unable to map %zu bytes: %s\n", size, strerror(errno));
+        return nullptr;
+    }
+    return p;
+
+#elif defined(_WIN32)
+    // Address space only; platform_commit backs it as it is used
+    void* p = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    if (p == nullptr) {
+        printf("Unable to reserve %zu bytes (error %lu)\n", size,
+               GetLastError());
+    }
+    return p;
+#else
+#    error Platform not supported.
+#endif
+}
+
+bool Platform::platform_commit(void* p, std::size_t size)
+{
+#if defined(__linux__)
+    // Already backed on first touch by the MAP_NORESERVE mapping
+    (void)p;
+    (void)size;
+    return true;
+
+#elif defined(_WIN32)
+    if (VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+        printf("Unable to commit %zu bytes (error %lu)\n", size,
+               GetLastError());
+        return false;
+    }
+    return true;
+#else
+#    error Platform not supported.
+#endif
+}
+
+void Platform::platform_free(void* p, std::size_t size)
+{
+    if (p == nullptr) { return; }
+
+#if defined(__linux__)
+    munmap(p, size);
+#elif defined(_WIN32)
+    (void)size;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+#    error Platform not supported.
+#endif
+}
+
 #if defined(_WIN32)
 void Platform::print_windows_error(LPCTSTR function_name) const
 {
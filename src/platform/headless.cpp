@@ -0,0 +1,156 @@
+#include "platform/headless.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#    include <time.h>
+#elif defined(_WIN32)
+#    include <Windows.h>
+#endif
+
+static u64 monotonic_ns()
+{
+#if defined(__linux__)
+    timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<u64>(now.tv_sec) * 1000000000ull +
+           static_cast<u64>(now.tv_nsec);
+#elif defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return static_cast<u64>(static_cast<f64>(counter.QuadPart) * 1.0e9 /
+                            static_cast<f64>(frequency.QuadPart));
+#else
+#    error Platform not supported.
+#endif
+}
+
+Headless::Headless(char const* script_path) : start_counter(monotonic_ns())
+{
+    if (script_path != nullptr) { load_script(script_path); }
+}
+
+void Headless::load_script(char const* script_path)
+{
+    std::ifstream file(script_path);
+    if (file.fail()) {
+        printf("Unable to open input script '%s'\n", script_path);
+        return;
+    }
+
+    static constexpr struct {
+        char const* name;
+        u32 action;
+    } actions[] = {
+        {"up", press_up},               {"down", press_down},
+        {"left", press_left},           {"right", press_right},
+        {"reveal", press_reveal},       {"flag", press_flag},
+        {"undo", press_undo},           {"redo", press_redo},
+        {"pan_up", press_pan_up},       {"pan_down", press_pan_down},
+        {"pan_left", press_pan_left},   {"pan_right", press_pan_right},
+        {"zoom_in", press_zoom_in},     {"zoom_out", press_zoom_out},
+        {"pause", action_pause},        {"overlay", action_overlay},
+        {"quit", action_quit},
+    };
+
+    std::string line;
+    s32 line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        if (!line.empty() && line[0] == '#') { continue; }
+
+        std::istringstream tokens(line);
+        std::string token;
+        u32 mask = 0;
+        bool waited = false;
+        while (tokens >> token) {
+            if (token == "wait") {
+                s32 polls = 0;
+                tokens >> polls;
+                const u32 count = static_cast<u32>(std::max(polls, 0));
+                script.insert(script.end(), count, 0);
+                waited = true;
+                continue;
+            }
+
+            bool known = false;
+            for (const auto& a : actions) {
+                if (token == a.name) {
+                    mask |= a.action;
+                    known = true;
+                }
+            }
+            if (!known) {
+                printf("%s:%d: unknown input script action '%s'\n",
+                       script_path, line_number, token.c_str());
+            }
+        }
+
+        // A line of only waits is already its polls
+        if (!waited || mask != 0) { script.push_back(mask); }
+    }
+}
+
+void Headless::create_open_gl_rendering_context(char const*, s32, s32, s32,
+                                                s32)
+{}
+
+void Headless::swap_window_buffer() {}
+
+void Headless::set_window_size(u32, u32) {}
+
+void Headless::process_sys_event_queue()
+{
+    Game_State& state = input.state;
+    Game_Input_Controller& keyboard = input.controllers[Controller::keyboard];
+
+    // Every scripted press is a full down/up within one poll
+    state.toggle_pause = false;
+    state.toggle_overlay = false;
+    state.request_redraw = false;
+    for (Game_Input_Button& button : keyboard.buttons) { button = {}; }
+
+    if (script_pos >= script.size()) {
+        state.request_quit = true;
+        return;
+    }
+
+    const u32 mask = script[script_pos++];
+    Game_Input_Button* const buttons[] = {
+        &keyboard.up,        &keyboard.down,      &keyboard.left,
+        &keyboard.right,     &keyboard.reveal,    &keyboard.flag,
+        &keyboard.undo,      &keyboard.redo,      &keyboard.pan_up,
+        &keyboard.pan_down,  &keyboard.pan_left,  &keyboard.pan_right,
+        &keyboard.zoom_in,   &keyboard.zoom_out,
+    };
+    for (u32 i = 0; i < sizeof(buttons) / sizeof(buttons[0]); ++i) {
+        if (mask & (1u << i)) { buttons[i]->half_transitions = 2; }
+    }
+
+    state.toggle_pause = (mask & action_pause) != 0;
+    state.toggle_overlay = (mask & action_overlay) != 0;
+    state.request_quit = (mask & action_quit) != 0;
+}
+
+bool Headless::wait_sys_event_queue(u32)
+{
+    // The script is always ready; never block
+    process_sys_event_queue();
+    return true;
+}
+
+Game_Input* Headless::get_input() { return &input; }
+
+u32 Headless::get_ticks()
+{
+    return static_cast<u32>((monotonic_ns() - start_counter) / 1000000);
+}
+
+u64 Headless::get_performance_frequency() { return 1000000000ull; }
+
+u64 Headless::get_performance_counter() { return monotonic_ns(); }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "input.h"
+#include "platform.h"
+#include "types.h"
+#include <string>
+#include <vector>
+
+/**
+   Platform without a display, for benchmarks and servers.
+
+   Input comes from a script instead of the OS. Each line of the script is
+   one poll of the event queue and holds whitespace separated actions:
+
+       up down left right reveal flag undo redo
+       pan_up pan_down pan_left pan_right zoom_in zoom_out
+       pause overlay quit
+
+   An empty line is a poll with no input and "wait N" is N such polls. Lines
+   starting with '#' are comments. When the script runs out the platform
+   requests quit.
+
+   Performance counters come from the monotonic clock in nanoseconds. There
+   is no rendering context, so pair it with Null_Renderer.
+ */
+class Headless : public Platform {
+public:
+    // A null script path runs an empty script, which quits on the first poll
+    explicit Headless(char const* script_path);
+    Headless(const Headless& o) = delete;
+    ~Headless() override = default;
+
+    void create_open_gl_rendering_context(char const* window_name,
+                                          s32 gl_major_version,
+                                          s32 gl_minor_version,
+                                          s32 window_width,
+                                          s32 window_height) override;
+    void swap_window_buffer() override;
+    void process_sys_event_queue() override;
+    bool wait_sys_event_queue(u32 timeout_ms) override;
+    Game_Input* get_input() override;
+    u32 get_ticks() override;
+    u64 get_performance_frequency() override;
+    u64 get_performance_counter() override;
+    void set_window_size(u32 w, u32 h) override;
+
+    Headless& operator=(const Headless& o) = delete;
+
+private:
+    enum Script_Action : u32 {
+        press_up = 1 << 0,
+        press_down = 1 << 1,
+        press_left = 1 << 2,
+        press_right = 1 << 3,
+        press_reveal = 1 << 4,
+        press_flag = 1 << 5,
+        press_undo = 1 << 6,
+        press_redo = 1 << 7,
+        press_pan_up = 1 << 8,
+        press_pan_down = 1 << 9,
+        press_pan_left = 1 << 10,
+        press_pan_right = 1 << 11,
+        press_zoom_in = 1 << 12,
+        press_zoom_out = 1 << 13,
+        action_pause = 1 << 14,
+        action_overlay = 1 << 15,
+        action_quit = 1 << 16,
+    };
+
+    // One entry per poll, a mask of Script_Action
+    std::vector<u32> script{};
+    std::size_t script_pos = 0;
+    Game_Input input = {};
+    u64 start_counter;
+
+    void load_script(char const* script_path);
+};
@@ -0,0 +1,217 @@
+#include "platform/hw_counters.h"
+
+#include <cstdio>
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    include <cerrno>
+#    include <cstring>
+#endif
+
+static std::atomic<bool> counters_enabled{false};
+static std::atomic<Hw_Counter_Zone*> zone_list{nullptr};
+
+#if defined(__linux__)
+
+namespace {
+    constexpr u64 event_configs[] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    constexpr int event_count =
+        sizeof(event_configs) / sizeof(event_configs[0]);
+
+    /**
+       Event group counting the owning thread. Counters are per thread, so
+       each instrumented thread opens its own group on first use.
+     */
+    struct Thread_Counters {
+        int fds[event_count] = {-1, -1, -1, -1};
+        bool open = false;
+
+        Thread_Counters()
+        {
+            for (int i = 0; i < event_count; ++i) {
+                perf_event_attr attr = {};
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = event_configs[i];
+                attr.disabled = (i == 0) ? 1 : 0; // leader starts the group
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP |
+                                   PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                const int group_fd = (i == 0) ? -1 : fds[0];
+                fds[i] = static_cast<int>(
+                    syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+                if (fds[i] < 0) {
+                    printf("perf_event_open failed for event %d: %s\n", i,
+                           strerror(errno));
+                    close_all();
+                    return;
+                }
+            }
+
+            ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            open = true;
+        }
+        Thread_Counters(const Thread_Counters& o) = delete;
+        ~Thread_Counters() { close_all(); }
+
+        Thread_Counters& operator=(const Thread_Counters& o) = delete;
+
+        void close_all()
+        {
+            for (int& fd : fds) {
+                if (fd >= 0) { close(fd); }
+                fd = -1;
+            }
+            open = false;
+        }
+
+        bool read_values(Hw_Counter_Values* values) const
+        {
+            struct {
+                u64 nr;
+                u64 time_enabled;
+                u64 time_running;
+                u64 values[event_count];
+            } group = {};
+
+            if (!open || read(fds[0], &group, sizeof(group)) !=
+                             static_cast<ssize_t>(sizeof(group))) {
+                return false;
+            }
+
+            values->cycles = group.values[0];
+            values->instructions = group.values[1];
+            values->cache_misses = group.values[2];
+            values->branch_misses = group.values[3];
+            values->time_enabled = group.time_enabled;
+            values->time_running = group.time_running;
+            return true;
+        }
+    };
+
+    Thread_Counters& thread_counters()
+    {
+        thread_local Thread_Counters counters;
+        return counters;
+    }
+} // namespace
+
+static bool read_counters(Hw_Counter_Values* values)
+{
+    return thread_counters().read_values(values);
+}
+
+bool hw_counters_enable()
+{
+    if (!thread_counters().open) { return false; }
+    counters_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+#else
+
+static bool read_counters(Hw_Counter_Values*) { return false; }
+
+bool hw_counters_enable() { return false; }
+
+#endif
+
+bool hw_counters_enabled()
+{
+    return counters_enabled.load(std::memory_order_relaxed);
+}
+
+Hw_Counter_Zone::Hw_Counter_Zone(char const* name)
+    : name(name), next(zone_list.load(std::memory_order_relaxed))
+{
+    while (!zone_list.compare_exchange_weak(next, this)) {}
+}
+
+void Hw_Counter_Zone::add(const Hw_Counter_Values& delta, u64 cell_count)
+{
+    calls.fetch_add(1, std::memory_order_relaxed);
+    cells.fetch_add(cell_count, std::memory_order_relaxed);
+    cycles.fetch_add(delta.cycles, std::memory_order_relaxed);
+    instructions.fetch_add(delta.instructions, std::memory_order_relaxed);
+    cache_misses.fetch_add(delta.cache_misses, std::memory_order_relaxed);
+    branch_misses.fetch_add(delta.branch_misses, std::memory_order_relaxed);
+    if (delta.time_running < delta.time_enabled) {
+        multiplexed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Hw_Counter_Zone::report() const
+{
+    const u64 n = calls.load();
+    if (n == 0 && unscheduled.load() == 0) { return; }
+
+    const f64 c = static_cast<f64>(cycles.load());
+    const f64 per_cell = static_cast<f64>(cells.load() > 0 ? cells.load() : 1);
+    printf("%-12s calls %-6llu cells %-10llu IPC %5.2f  cycles/cell %8.2f  "
+           "cache-miss/cell %7.4f  branch-miss/cell %7.4f\n",
+           name, static_cast<unsigned long long>(n),
+           static_cast<unsigned long long>(cells.load()),
+           (c > 0.0) ? static_cast<f64>(instructions.load()) / c : 0.0,
+           c / per_cell, static_cast<f64>(cache_misses.load()) / per_cell,
+           static_cast<f64>(branch_misses.load()) / per_cell);
+    if (multiplexed.load() > 0 || unscheduled.load() > 0) {
+        printf("%-12s %llu calls multiplexed and scaled, %llu never "
+               "scheduled\n",
+               "", static_cast<unsigned long long>(multiplexed.load()),
+               static_cast<unsigned long long>(unscheduled.load()));
+    }
+}
+
+void hw_counters_report()
+{
+    for (Hw_Counter_Zone* zone = zone_list.load(); zone != nullptr;
+         zone = zone->next) {
+        zone->report();
+    }
+}
+
+Hw_Counter_Scope::Hw_Counter_Scope(Hw_Counter_Zone* zone)
+    : zone(zone), start(), active(hw_counters_enabled())
+{
+    if (active) { active = read_counters(&start); }
+}
+
+Hw_Counter_Scope::~Hw_Counter_Scope()
+{
+    if (!active) { return; }
+
+    Hw_Counter_Values end = {};
+    if (!read_counters(&end)) { return; }
+
+    const u64 enabled = end.time_enabled - start.time_enabled;
+    const u64 running = end.time_running - start.time_running;
+    if (running == 0) {
+        zone->add_unscheduled();
+        return;
+    }
+
+    // Extrapolate counts to the whole scope when the group was multiplexed
+    // off the PMU for part of it
+    const f64 scale = static_cast<f64>(enabled) / static_cast<f64>(running);
+    const auto scaled = [scale](u64 count) {
+        return static_cast<u64>(static_cast<f64>(count) * scale + 0.5);
+    };
+    zone->add({scaled(end.cycles - start.cycles),
+               scaled(end.instructions - start.instructions),
+               scaled(end.cache_misses - start.cache_misses),
+               scaled(end.branch_misses - start.branch_misses), enabled,
+               running},
+              cells);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "types.h"
+#include <atomic>
+
+struct Hw_Counter_Values {
+    u64 cycles;
+    u64 instructions;
+    u64 cache_misses;
+    u64 branch_misses;
+    // Nanoseconds the group was enabled and actually counting. They differ
+    // when the kernel multiplexes more events than the PMU has counters.
+    u64 time_enabled;
+    u64 time_running;
+};
+
+/**
+   Accumulated hardware counters of one instrumented zone.
+
+   Define zones with static storage duration; they register themselves and
+   are printed by hw_counters_report(). The cell count is whatever unit of
+   work the zone processes, so the report can normalise misses per cell.
+   Samples taken while the counters were multiplexed are scaled up to the
+   whole scope and counted separately, since they are estimates.
+ */
+class Hw_Counter_Zone {
+public:
+    explicit Hw_Counter_Zone(char const* name);
+    Hw_Counter_Zone(const Hw_Counter_Zone& o) = delete;
+
+    void add(const Hw_Counter_Values& delta, u64 cells);
+    // A sample that never had the counters scheduled and has no estimate
+    void add_unscheduled() { unscheduled.fetch_add(1); }
+    void report() const;
+
+    Hw_Counter_Zone& operator=(const Hw_Counter_Zone& o) = delete;
+
+private:
+    char const* name;
+    std::atomic<u64> calls{0};
+    std::atomic<u64> cells{0};
+    std::atomic<u64> cycles{0};
+    std::atomic<u64> instructions{0};
+    std::atomic<u64> cache_misses{0};
+    std::atomic<u64> branch_misses{0};
+    std::atomic<u64> multiplexed{0};
+    std::atomic<u64> unscheduled{0};
+
+    Hw_Counter_Zone* next;
+    friend void hw_counters_report();
+};
+
+/**
+   Counts hardware events on the calling thread for the lifetime of the
+   scope and adds them to a zone. Does nothing unless counters were enabled
+   with hw_counters_enable().
+ */
+class Hw_Counter_Scope {
+public:
+    explicit Hw_Counter_Scope(Hw_Counter_Zone* zone);
+    Hw_Counter_Scope(const Hw_Counter_Scope& o) = delete;
+    ~Hw_Counter_Scope();
+
+    void add_cells(u64 count) { cells += count; }
+
+    Hw_Counter_Scope& operator=(const Hw_Counter_Scope& o) = delete;
+
+private:
+    Hw_Counter_Zone* zone;
+    Hw_Counter_Values start;
+    u64 cells = 0;
+    bool active;
+};
+
+// Open the counters (Linux perf_event_open). Returns false if hardware
+// counters are unavailable on this platform or to this process, e.g. due to
+// /proc/sys/kernel/perf_event_paranoid or a VM without a virtual PMU.
+bool hw_counters_enable();
+[[nodiscard]] bool hw_counters_enabled();
+void hw_counters_report();
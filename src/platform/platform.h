@@ -1,6 +1,7 @@
 #pragma once
 
 #include "input.h"
+#include "memory_arena.h"
 #include "types.h"
 #include <cstdio>
 
@@ -20,9 +21,10 @@ public:
     virtual u32 get_ticks() = 0;
     virtual u64 get_performance_frequency() = 0;
     virtual u64 get_performance_counter() = 0;
-    // virtual void *platform_alloc(size_t size) = 0;
-    // virtual void platform_free(void *p) = 0;
     virtual void process_sys_event_queue() = 0;
+    // Block until at least one system event arrives or the timeout expires,
+    // then process the queue. Returns false on timeout.
+    virtual bool wait_sys_event_queue(u32 timeout_ms) = 0;
     virtual Game_Input* get_input() = 0;
     virtual void create_open_gl_rendering_context(char const* window_name,
                                                   s32 gl_major_version,
@@ -33,8 +35,36 @@ public:
     virtual void set_window_size(u32 w, u32 h) = 0;
 
     void set_process_to_high_priority() const;
+    // Block the calling thread for at least the given time. The OS may
+    // oversleep by its scheduler granularity.
+    void sleep_us(u64 microseconds) const;
+    // Peak resident memory of the process in bytes, or 0 if unknown
+    [[nodiscard]] u64 get_peak_memory_usage() const;
+
+    // Zeroed, page aligned address space straight from the OS, for large
+    // long-lived blocks. Returns null on failure. Commit a range with
+    // platform_commit before touching it. Free with the size it was
+    // allocated with.
+    static void* platform_alloc(std::size_t size);
+    static bool platform_commit(void* p, std::size_t size);
+    static void platform_free(void* p, std::size_t size);
+
+    // Scratch memory for the current frame, released when the frame loop
+    // resets it at the start of the next frame
+    Memory_Arena* get_frame_arena() { return &frame_arena; }
+    // Memory that lives until the platform shuts down: the board, its undo
+    // journal and renderer caches sized by the board
+    Memory_Arena* get_permanent_arena() { return &permanent_arena; }
 
  private:
+    static constexpr std::size_t frame_arena_capacity = 16 * 1024 * 1024;
+    // Address space only, committed as it is used. Room for large boards,
+    // their summary pyramid and a long journal.
+    static constexpr std::size_t permanent_arena_capacity = 16ull << 30;
+
+    Memory_Arena frame_arena{frame_arena_capacity};
+    Memory_Arena permanent_arena{permanent_arena_capacity};
+
 #if defined(_WIN32)
     void print_windows_error(LPCTSTR function_name) const;
 #endif
@@ -1,5 +1,6 @@
 #include "platform/sdl2.h"
 
+#include "perf/profiler.h"
 #include <system_error>
 
 Sdl2::Sdl2() : input(), new_input(input), old_input(input + 1)
@@ -83,39 +84,68 @@ void Sdl2::create_open_gl_rendering_context(char const* window_name,
     }
 }
 
-void Sdl2::swap_window_buffer() { SDL_GL_SwapWindow(window); }
+void Sdl2::swap_window_buffer()
+{
+    PROFILE_FUNCTION();
+    SDL_GL_SwapWindow(window);
+}
 
 void Sdl2::process_sys_event_queue()
 {
-    Game_State* state = &new_input->state;
+    PROFILE_FUNCTION();
+
     SDL_Event event;
 
     // Setup for new system input
     prepare_for_new_input();
 
     // Loop through waiting events
-    while (SDL_PollEvent(&event)) {
-        // Handle event
-        switch (event.type) {
-            case SDL_QUIT: {
-                state->request_quit = true;
-            } break;
+    while (SDL_PollEvent(&event)) { process_event(&event); }
+}
 
-            case SDL_KEYDOWN: {
-                process_keyboard_event(&event, true);
-            } break;
+bool Sdl2::wait_sys_event_queue(u32 timeout_ms)
+{
+    SDL_Event event;
 
-            case SDL_KEYUP: {
-                process_keyboard_event(&event, false);
-            } break;
+    // Setup for new system input
+    prepare_for_new_input();
 
-            case SDL_WINDOWEVENT: {
-                process_window_event(&event.window);
-            } break;
+    // Block until the first event arrives, then drain the rest
+    if (!SDL_WaitEventTimeout(&event, static_cast<int>(timeout_ms))) {
+        return false;
+    }
 
-            default: {
-            } break;
-        }
+    do {
+        process_event(&event);
+    } while (SDL_PollEvent(&event));
+
+    return true;
+}
+
+void Sdl2::process_event(SDL_Event* event)
+{
+    Game_State* state = &new_input->state;
+
+    // Handle event
+    switch (event->type) {
+        case SDL_QUIT: {
+            state->request_quit = true;
+        } break;
+
+        case SDL_KEYDOWN: {
+            process_keyboard_event(event, true);
+        } break;
+
+        case SDL_KEYUP: {
+            process_keyboard_event(event, false);
+        } break;
+
+        case SDL_WINDOWEVENT: {
+            process_window_event(&event->window);
+        } break;
+
+        default: {
+        } break;
     }
 }
 
@@ -132,8 +162,13 @@ void Sdl2::prepare_for_new_input()
     Game_Input_Controller* old_keyboard =
         &old_input->controllers[Controller::keyboard];
 
+    // Carry over persistent window state
+    new_game_state.window_hidden = old_input->state.window_hidden;
+
     // Reset toggles
     new_game_state.toggle_pause = false;
+    new_game_state.toggle_overlay = false;
+    new_game_state.request_redraw = false;
 
     // Zero the new keyboard
     *new_keyboard = zeroed_input.controllers[0];
@@ -173,28 +208,33 @@ void Sdl2::process_window_event(SDL_WindowEvent* event)
         // NOTE(sdsmith): https://wiki.libsdl.org/SDL_WindowEventID
         switch (event->event) {
             case SDL_WINDOWEVENT_SHOWN: {
+                state->window_hidden = false;
+                state->request_redraw = true;
             } break;
 
             case SDL_WINDOWEVENT_HIDDEN: {
-                // TODO(sdsmith): stop drawing
+                state->window_hidden = true;
             } break;
 
             case SDL_WINDOWEVENT_EXPOSED: {
-                // TODO(sdsmith): redraw
+                state->request_redraw = true;
             } break;
 
             case SDL_WINDOWEVENT_SIZE_CHANGED: {
+                state->request_redraw = true;
                 // NOTE(sdsmith): window size has changed
                 // TODO(sdsmith): assuming it has changed to data1 by data2
                 // reshape(event->data1, window_event->data2);
             } break;
 
             case SDL_WINDOWEVENT_MINIMIZED: {
-                // TODO(sdsmith): pause game
+                state->window_hidden = true;
             } break;
 
-            case SDL_WINDOWEVENT_MAXIMIZED: {
-                // TODO(sdsmith): run game. (will this be followed by a shown?)
+            case SDL_WINDOWEVENT_MAXIMIZED:
+            case SDL_WINDOWEVENT_RESTORED: {
+                state->window_hidden = false;
+                state->request_redraw = true;
             } break;
 
             case SDL_WINDOWEVENT_ENTER: {
@@ -248,10 +288,58 @@ void Sdl2::process_keyboard_event(SDL_Event* event, bool key_down)
             process_input_button(&keyboard.right, key_down);
         } break;
 
+        case SDLK_SPACE: {
+            process_input_button(&keyboard.reveal, key_down);
+        } break;
+
+        case SDLK_f: {
+            process_input_button(&keyboard.flag, key_down);
+        } break;
+
+        case SDLK_z: {
+            process_input_button(&keyboard.undo, key_down);
+        } break;
+
+        case SDLK_y: {
+            process_input_button(&keyboard.redo, key_down);
+        } break;
+
+        case SDLK_UP: {
+            process_input_button(&keyboard.pan_up, key_down);
+        } break;
+
+        case SDLK_DOWN: {
+            process_input_button(&keyboard.pan_down, key_down);
+        } break;
+
+        case SDLK_LEFT: {
+            process_input_button(&keyboard.pan_left, key_down);
+        } break;
+
+        case SDLK_RIGHT: {
+            process_input_button(&keyboard.pan_right, key_down);
+        } break;
+
+        // '+' shares a key with '=' on most layouts
+        case SDLK_EQUALS:
+        case SDLK_PLUS:
+        case SDLK_KP_PLUS: {
+            process_input_button(&keyboard.zoom_in, key_down);
+        } break;
+
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS: {
+            process_input_button(&keyboard.zoom_out, key_down);
+        } break;
+
         case SDLK_p: {
             if (!key_down) { game_state.toggle_pause = true; }
         } break;
 
+        case SDLK_F1: {
+            if (!key_down) { game_state.toggle_overlay = true; }
+        } break;
+
         case SDLK_ESCAPE: {
             if (!key_down) { game_state.request_quit = true; }
         } break;
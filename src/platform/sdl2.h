@@ -18,6 +18,7 @@ public:
                                           s32 window_height) override;
     void swap_window_buffer() override;
     void process_sys_event_queue() override;
+    bool wait_sys_event_queue(u32 timeout_ms) override;
     Game_Input* get_input() override;
     u32 get_ticks() override;
     u64 get_performance_frequency() override;
@@ -38,6 +39,7 @@ private:
         zeroed_input; // TODO(sdsmith): confirm 0-initializaton
 
     void prepare_for_new_input();
+    void process_event(SDL_Event* event);
     void process_window_event(SDL_WindowEvent* event);
     void process_keyboard_event(SDL_Event* event, bool key_down);
     void process_input_button(Game_Input_Button* button, bool button_down);
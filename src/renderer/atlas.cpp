@@ -0,0 +1,118 @@
+#include "renderer/atlas.h"
+
+#include <algorithm>
+#include <numeric>
+
+static s32 round_up(s32 value, s32 multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+Atlas_Builder::Atlas_Builder(s32 padding) : padding(1)
+{
+    while (this->padding < padding) { this->padding *= 2; }
+}
+
+u32 Atlas_Builder::add_sprite(s32 width, s32 height, const u32* pixels,
+                              s32 stride)
+{
+    sprites.push_back({width, height, sprite_pixels.size()});
+    for (s32 y = 0; y < height; ++y) {
+        sprite_pixels.insert(sprite_pixels.end(), pixels + y * stride,
+                             pixels + y * stride + width);
+    }
+
+    return static_cast<u32>(sprites.size() - 1);
+}
+
+bool Atlas_Builder::build(s32 max_size, Texture_Atlas* atlas) const
+{
+    // Cell of each sprite with padding on every side, on the padding grid
+    auto cell_width = [this](const Sprite& s) {
+        return round_up(s.width + 2 * padding, padding);
+    };
+    auto cell_height = [this](const Sprite& s) {
+        return round_up(s.height + 2 * padding, padding);
+    };
+
+    std::vector<u32> order(sprites.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+        return sprites[a].height > sprites[b].height;
+    });
+
+    // Start from a square power of two big enough for the total area and
+    // widen until the shelves fit
+    s64 area = 0;
+    s32 widest = 0;
+    for (const Sprite& s : sprites) {
+        area += static_cast<s64>(cell_width(s)) * cell_height(s);
+        widest = std::max(widest, cell_width(s));
+    }
+    s32 width = 1;
+    while (static_cast<s64>(width) * width < area || width < widest) {
+        width *= 2;
+    }
+
+    std::vector<s32> cell_x(sprites.size());
+    std::vector<s32> cell_y(sprites.size());
+    s32 height = 0;
+    for (; width <= max_size; width *= 2) {
+        s32 x = 0;
+        s32 shelf_y = 0;
+        s32 shelf_height = 0;
+        for (u32 i : order) {
+            const Sprite& s = sprites[i];
+            if (x + cell_width(s) > width) {
+                shelf_y += shelf_height;
+                x = 0;
+                shelf_height = 0;
+            }
+            cell_x[i] = x;
+            cell_y[i] = shelf_y;
+            x += cell_width(s);
+            shelf_height = std::max(shelf_height, cell_height(s));
+        }
+
+        height = 1;
+        while (height < shelf_y + shelf_height) { height *= 2; }
+        if (height <= width) { break; }
+    }
+    if (width > max_size || height > max_size) { return false; }
+
+    atlas->width = width;
+    atlas->height = height;
+    atlas->pixels.assign(static_cast<std::size_t>(width) * height, 0);
+    atlas->uvs.resize(sprites.size());
+
+    s32 level = 0;
+    while ((1 << (level + 1)) <= padding) { level++; }
+    atlas->max_mip_level = level;
+
+    for (std::size_t i = 0; i < sprites.size(); ++i) {
+        const Sprite& s = sprites[i];
+        const s32 x0 = cell_x[i] + padding;
+        const s32 y0 = cell_y[i] + padding;
+
+        // Sprite plus padding, with the padding clamped to the edge pixels
+        for (s32 y = -padding; y < s.height + padding; ++y) {
+            const s32 sy = std::clamp(y, 0, s.height - 1);
+            for (s32 x = -padding; x < s.width + padding; ++x) {
+                const s32 sx = std::clamp(x, 0, s.width - 1);
+                atlas->pixels[static_cast<std::size_t>(y0 + y) * width + x0 +
+                              x] =
+                    sprite_pixels[s.first_pixel +
+                                  static_cast<std::size_t>(sy) * s.width + sx];
+            }
+        }
+
+        atlas->uvs[i] = {static_cast<f32>(x0) / static_cast<f32>(width),
+                         static_cast<f32>(y0) / static_cast<f32>(height),
+                         static_cast<f32>(x0 + s.width) /
+                             static_cast<f32>(width),
+                         static_cast<f32>(y0 + s.height) /
+                             static_cast<f32>(height)};
+    }
+
+    return true;
+}
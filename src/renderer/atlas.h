@@ -0,0 +1,57 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+
+// Texture coordinates of a sprite, top left (u0, v0) to bottom right (u1, v1)
+struct Atlas_Uv {
+    f32 u0;
+    f32 v0;
+    f32 u1;
+    f32 v1;
+};
+
+struct Texture_Atlas {
+    s32 width = 0;
+    s32 height = 0;
+    // RGBA8, 0xAABBGGRR, top row first
+    std::vector<u32> pixels{};
+    // Indexed by the id add_sprite returned
+    std::vector<Atlas_Uv> uvs{};
+    // Highest mip level at which no sprite bleeds into its neighbours
+    s32 max_mip_level = 0;
+};
+
+/**
+   Packs sprites into a single texture so everything drawn from them can
+   share one texture binding.
+
+   Sprites are placed on shelves, tallest first. Each sprite is surrounded by
+   padding filled with copies of its edge pixels, and placed on a grid of
+   the padding size. At mip level log2(padding) a sprite and its padding
+   still cover whole texels of their own, so filtering and mipmapping never
+   mix in a neighbouring sprite up to that level.
+ */
+class Atlas_Builder {
+public:
+    // Padding is rounded up to a power of two
+    explicit Atlas_Builder(s32 padding);
+
+    // Copies the sprite. Returns its index into Texture_Atlas::uvs.
+    u32 add_sprite(s32 width, s32 height, const u32* pixels, s32 stride);
+
+    // Returns false if the sprites don't fit in max_size x max_size
+    bool build(s32 max_size, Texture_Atlas* atlas) const;
+
+private:
+    struct Sprite {
+        s32 width;
+        s32 height;
+        // Offset into sprite_pixels
+        std::size_t first_pixel;
+    };
+
+    s32 padding;
+    std::vector<Sprite> sprites{};
+    std::vector<u32> sprite_pixels{};
+};
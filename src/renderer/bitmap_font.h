@@ -0,0 +1,69 @@
+#pragma once
+
+#include "types.h"
+
+// 3x5 pixel bitmap font
+constexpr s32 glyph_width = 3;
+constexpr s32 glyph_height = 5;
+
+/**
+   Bitmap of a glyph, 3 bits per row from the top row down, most significant
+   bit leftmost. Lowercase letters map to uppercase; unsupported characters
+   are blank.
+ */
+constexpr u16 glyph_bits(char c)
+{
+    if (c >= 'a' && c <= 'z') { c = static_cast<char>(c - 'a' + 'A'); }
+
+    switch (c) {
+        case '%': return 0x52a5;
+        case '-': return 0x01c0;
+        case '.': return 0x0002;
+        case '/': return 0x12a4;
+        case '0': return 0x7b6f;
+        case '1': return 0x2c97;
+        case '2': return 0x73e7;
+        case '3': return 0x73cf;
+        case '4': return 0x5bc9;
+        case '5': return 0x79cf;
+        case '6': return 0x79ef;
+        case '7': return 0x7249;
+        case '8': return 0x7bef;
+        case '9': return 0x7bcf;
+        case ':': return 0x0410;
+        case 'A': return 0x2bed;
+        case 'B': return 0x6bae;
+        case 'C': return 0x3923;
+        case 'D': return 0x6b6e;
+        case 'E': return 0x79a7;
+        case 'F': return 0x79a4;
+        case 'G': return 0x396b;
+        case 'H': return 0x5bed;
+        case 'I': return 0x7497;
+        case 'J': return 0x126a;
+        case 'K': return 0x5bad;
+        case 'L': return 0x4927;
+        case 'M': return 0x5fed;
+        case 'N': return 0x6b6d;
+        case 'O': return 0x2b6a;
+        case 'P': return 0x6ba4;
+        case 'Q': return 0x2b73;
+        case 'R': return 0x6bad;
+        case 'S': return 0x388e;
+        case 'T': return 0x7492;
+        case 'U': return 0x5b6f;
+        case 'V': return 0x5b6a;
+        case 'W': return 0x5bfd;
+        case 'X': return 0x5aad;
+        case 'Y': return 0x5a92;
+        case 'Z': return 0x72a7;
+        default: return 0;
+    }
+}
+
+constexpr bool glyph_pixel(u16 bits, s32 x, s32 y)
+{
+    const s32 bit =
+        (glyph_height - 1 - y) * glyph_width + (glyph_width - 1 - x);
+    return (bits >> bit) & 1u;
+}
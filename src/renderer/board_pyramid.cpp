@@ -0,0 +1,130 @@
+#include "renderer/board_pyramid.h"
+
+#include "perf/profiler.h"
+#include <algorithm>
+#include <cassert>
+
+static constexpr u32 revealed_bits = 0x000000ff;
+static constexpr u32 flagged_bits = 0x0000ff00;
+static constexpr u32 mine_bits = 0x00ff0000;
+
+static u32 cell_summary(const Grid& board, u32 i)
+{
+    switch (board.get_state(i)) {
+        case Cell_State::hidden: return 0;
+        case Cell_State::flagged: return flagged_bits;
+        case Cell_State::revealed: {
+            return (board.get(i) == mine_val) ? (revealed_bits | mine_bits)
+                                              : revealed_bits;
+        }
+        default: return 0;
+    }
+}
+
+static std::size_t texel_index(const Board_Pyramid::Level& level, s32 x, s32 y)
+{
+    return static_cast<std::size_t>(y) * static_cast<std::size_t>(level.width) +
+           static_cast<std::size_t>(x);
+}
+
+// Average of the texels of the level below under (x, y). Levels halve
+// rounding down, like GL mip levels, so the last row and column of a level
+// also cover the odd texel left over below.
+static u32 average_children(const Board_Pyramid::Level& below,
+                            const Board_Pyramid::Level& level, s32 x, s32 y)
+{
+    const s32 x0 = 2 * x;
+    const s32 y0 = 2 * y;
+    const s32 x1 = (x == level.width - 1) ? below.width : x0 + 2;
+    const s32 y1 = (y == level.length - 1) ? below.length : y0 + 2;
+
+    u32 sums[3] = {};
+    u32 count = 0;
+    for (s32 cy = y0; cy < y1; ++cy) {
+        for (s32 cx = x0; cx < x1; ++cx) {
+            const u32 texel = below.texels[texel_index(below, cx, cy)];
+            for (u32 c = 0; c < 3; ++c) {
+                sums[c] += (texel >> (8 * c)) & 0xff;
+            }
+            count++;
+        }
+    }
+
+    u32 texel = 0;
+    for (u32 c = 0; c < 3; ++c) {
+        texel |= ((sums[c] + count / 2) / count) << (8 * c);
+    }
+    return texel;
+}
+
+// Texels of level that summarize the texels in rect of the level below
+static Cell_Rect parent_rect(const Board_Pyramid::Level& level, Cell_Rect rect)
+{
+    return {std::min(rect.x0 / 2, level.width - 1),
+            std::min(rect.y0 / 2, level.length - 1),
+            std::min((rect.x1 - 1) / 2, level.width - 1) + 1,
+            std::min((rect.y1 - 1) / 2, level.length - 1) + 1};
+}
+
+void Board_Pyramid::build(const Grid& board, Memory_Arena* arena)
+{
+    PROFILE_FUNCTION();
+
+    const bool same_size = level_count > 0 &&
+                           levels[0].width == board.width() &&
+                           levels[0].length == board.length();
+    if (!same_size) {
+        level_count = 0;
+        s32 width = board.width();
+        s32 length = board.length();
+        for (;;) {
+            assert(level_count < max_levels);
+            const std::size_t texel_count = static_cast<std::size_t>(width) *
+                                            static_cast<std::size_t>(length);
+            levels[level_count++] = {width, length,
+                                     arena->push_array<u32>(texel_count)};
+            if (width == 1 && length == 1) { break; }
+            width = std::max(width / 2, 1);
+            length = std::max(length / 2, 1);
+        }
+    }
+
+    update(board, {0, 0, board.width(), board.length()});
+}
+
+void Board_Pyramid::update(const Grid& board, Cell_Rect rect)
+{
+    if (rect.empty()) { return; }
+
+    Level& base = levels[0];
+    for (s32 y = rect.y0; y < rect.y1; ++y) {
+        const u32 row = board.index(rect.x0, y);
+        for (s32 x = rect.x0; x < rect.x1; ++x) {
+            base.texels[texel_index(base, x, y)] =
+                cell_summary(board, row + static_cast<u32>(x - rect.x0));
+        }
+    }
+
+    for (std::size_t l = 1; l < level_count; ++l) {
+        Level& level = levels[l];
+        rect = parent_rect(level, rect);
+        for (s32 y = rect.y0; y < rect.y1; ++y) {
+            for (s32 x = rect.x0; x < rect.x1; ++x) {
+                level.texels[texel_index(level, x, y)] =
+                    average_children(levels[l - 1], level, x, y);
+            }
+        }
+    }
+}
+
+Cell_Rect Board_Pyramid::level_rect(std::size_t l, Cell_Rect rect) const
+{
+    assert(l < level_count);
+
+    // One level at a time, since the last row and column of a level also
+    // cover an odd texel left over below
+    for (std::size_t k = 1; k <= l; ++k) {
+        rect = parent_rect(levels[k], rect);
+    }
+    return rect;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "game/grid.h"
+#include "memory_arena.h"
+#include "types.h"
+#include <array>
+#include <cstddef>
+
+/**
+   Summary of a board for drawing it zoomed far out, as a mip pyramid.
+
+   Texels are RGBA8, 0xAABBGGRR: red is the fraction of revealed cells,
+   green flagged cells and blue revealed mines, with alpha unused. Level 0
+   has a texel per cell and each further level averages 2x2 texels of the
+   one below, down to a single texel.
+
+   update() only recomputes the texels over the changed cells, on every
+   level, and level_rect() says which texels those are so a renderer can
+   upload just that.
+ */
+class Board_Pyramid {
+public:
+    // Enough to halve any s32 board size down to one texel
+    static constexpr std::size_t max_levels = 32;
+
+    struct Level {
+        s32 width;
+        s32 length;
+        // Row-major
+        u32* texels;
+    };
+
+    // Size the levels for the board and summarize all of it. The texels
+    // come from the arena and are reused while the board size stays the
+    // same.
+    void build(const Grid& board, Memory_Arena* arena);
+    // Recompute the texels over the cells in rect
+    void update(const Grid& board, Cell_Rect rect);
+    // Texels of level l summarizing the cells in rect
+    [[nodiscard]] Cell_Rect level_rect(std::size_t l, Cell_Rect rect) const;
+
+    [[nodiscard]] std::size_t get_level_count() const { return level_count; }
+    [[nodiscard]] const Level& get_level(std::size_t l) const
+    {
+        return levels[l];
+    }
+
+private:
+    std::array<Level, max_levels> levels{};
+    std::size_t level_count = 0;
+};
@@ -0,0 +1,38 @@
+#include "renderer/camera.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Camera make_camera(const Grid& board)
+{
+    return {static_cast<f32>(board.width()) / 2.0f,
+            static_cast<f32>(board.length()) / 2.0f, 1.0f};
+}
+
+bool pan_camera(Camera* camera, const Grid& board, s32 steps_x, s32 steps_y)
+{
+    // A step is a fraction of the visible board, but at least a cell
+    const f32 width = static_cast<f32>(board.width());
+    const f32 length = static_cast<f32>(board.length());
+    const f32 step_x =
+        std::max(width / (camera->zoom * camera_pan_steps), 1.0f);
+    const f32 step_y =
+        std::max(length / (camera->zoom * camera_pan_steps), 1.0f);
+
+    const Camera old = *camera;
+    camera->center_x = std::clamp(
+        camera->center_x + static_cast<f32>(steps_x) * step_x, 0.0f, width);
+    camera->center_y = std::clamp(
+        camera->center_y + static_cast<f32>(steps_y) * step_y, 0.0f, length);
+    return std::memcmp(camera, &old, sizeof(old)) != 0;
+}
+
+bool zoom_camera(Camera* camera, s32 steps)
+{
+    const Camera old = *camera;
+    camera->zoom = std::clamp(
+        old.zoom * std::pow(camera_zoom_step, static_cast<f32>(steps)),
+        camera_min_zoom, camera_max_zoom);
+    return std::memcmp(camera, &old, sizeof(old)) != 0;
+}
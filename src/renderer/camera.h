@@ -0,0 +1,42 @@
+#pragma once
+
+#include "game/grid.h"
+#include "types.h"
+
+/**
+   2D view of the board.
+
+   The center is in cells, so (0, 0) is the top left corner of the board.
+   At zoom 1 the whole board fits the window; zoom scales the tile size from
+   there.
+ */
+struct Camera {
+    f32 center_x;
+    f32 center_y;
+    f32 zoom;
+};
+
+constexpr f32 camera_min_zoom = 1.0f;
+constexpr f32 camera_max_zoom = 4096.0f;
+// Zoom factor of one zoom step
+constexpr f32 camera_zoom_step = 1.25f;
+// Pan steps per view width or height at the current zoom
+constexpr f32 camera_pan_steps = 8.0f;
+
+// Centered on the board and zoomed out to fit it
+Camera make_camera(const Grid& board);
+
+/**
+   Move the view by whole pan steps, keeping the center on the board.
+
+   \return True if the view changed.
+ */
+bool pan_camera(Camera* camera, const Grid& board, s32 steps_x, s32 steps_y);
+
+/**
+   Zoom in (positive steps) or out about the center, within camera_min_zoom
+   and camera_max_zoom.
+
+   \return True if the view changed.
+ */
+bool zoom_camera(Camera* camera, s32 steps);
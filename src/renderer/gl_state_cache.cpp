@@ -0,0 +1,117 @@
+#include "renderer/gl_state_cache.h"
+
+#include "renderer/opengl.h"
+#include <cassert>
+
+void Gl_State_Cache::use_program(GLuint program)
+{
+    if (this->program == program) {
+        elided++;
+        return;
+    }
+    GL_CHECK(glUseProgram(program));
+    this->program = program;
+    issued++;
+}
+
+void Gl_State_Cache::bind_vertex_array(GLuint vao)
+{
+    if (this->vao == vao) {
+        elided++;
+        return;
+    }
+    GL_CHECK(glBindVertexArray(vao));
+    this->vao = vao;
+    issued++;
+}
+
+void Gl_State_Cache::set_active_unit(GLuint unit)
+{
+    if (active_unit == unit) {
+        elided++;
+        return;
+    }
+    GL_CHECK(glActiveTexture(GL_TEXTURE0 + unit));
+    active_unit = unit;
+    issued++;
+}
+
+void Gl_State_Cache::bind_texture(GLuint unit, GLuint texture)
+{
+    assert(unit < max_texture_units);
+
+    if (textures[unit] == texture) {
+        elided++;
+        return;
+    }
+    set_active_unit(unit);
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, texture));
+    textures[unit] = texture;
+    issued++;
+}
+
+void Gl_State_Cache::edit_texture(GLuint unit, GLuint texture)
+{
+    assert(unit < max_texture_units);
+
+    set_active_unit(unit);
+    bind_texture(unit, texture);
+}
+
+void Gl_State_Cache::set_blend(bool enable)
+{
+    const GLuint value = enable ? 1 : 0;
+    if (blend == value) {
+        elided++;
+        return;
+    }
+    if (enable) {
+        GL_CHECK(glEnable(GL_BLEND));
+    } else {
+        GL_CHECK(glDisable(GL_BLEND));
+    }
+    blend = value;
+    issued++;
+}
+
+void Gl_State_Cache::set_blend_func(GLenum src, GLenum dst)
+{
+    if (blend_src == src && blend_dst == dst) {
+        elided++;
+        return;
+    }
+    GL_CHECK(glBlendFunc(src, dst));
+    blend_src = src;
+    blend_dst = dst;
+    issued++;
+}
+
+void Gl_State_Cache::set_viewport(s32 x, s32 y, s32 width, s32 height)
+{
+    const std::array<s32, 4> value = {x, y, width, height};
+    if (viewport == value) {
+        elided++;
+        return;
+    }
+    GL_CHECK(glViewport(x, y, width, height));
+    viewport = value;
+    issued++;
+}
+
+void Gl_State_Cache::invalidate()
+{
+    program = unknown;
+    vao = unknown;
+    active_unit = unknown;
+    textures = make_unknown_textures();
+    blend = unknown;
+    blend_src = unknown;
+    blend_dst = unknown;
+    viewport = {-1, -1, -1, -1};
+}
+
+void Gl_State_Cache::reset_counters()
+{
+    issued = 0;
+    elided = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "types.h"
+#define GLEW_STATIC // Use GLEW static library
+#include <GL/glew.h>
+#include <array>
+
+/**
+   Shadow copy of the GL state the renderer changes most, so calls that
+   would set a value that is already current are skipped.
+
+   Every change of the cached state has to go through the cache, or the
+   cache has to be invalidated afterwards; otherwise a later call may be
+   skipped while GL holds a different value. State starts out unknown, so
+   the first call of each kind is always issued.
+ */
+class Gl_State_Cache {
+public:
+    static constexpr GLuint max_texture_units = 8;
+
+    void use_program(GLuint program);
+    void bind_vertex_array(GLuint vao);
+    // Bind for drawing. Leaves an unspecified unit active.
+    void bind_texture(GLuint unit, GLuint texture);
+    // Bind and make the unit active, for glTexImage2D and friends
+    void edit_texture(GLuint unit, GLuint texture);
+    void set_blend(bool enable);
+    void set_blend_func(GLenum src, GLenum dst);
+    void set_viewport(s32 x, s32 y, s32 width, s32 height);
+
+    // Forget everything, after GL state was changed behind the cache's back
+    void invalidate();
+
+    // GL calls made and skipped since the last reset
+    [[nodiscard]] u32 get_issued() const { return issued; }
+    [[nodiscard]] u32 get_elided() const { return elided; }
+    void reset_counters();
+
+private:
+    static constexpr GLuint unknown = ~0u;
+
+    GLuint program = unknown;
+    GLuint vao = unknown;
+    GLuint active_unit = unknown;
+    std::array<GLuint, max_texture_units> textures = make_unknown_textures();
+    // 0 disabled, 1 enabled, unknown
+    GLuint blend = unknown;
+    GLenum blend_src = unknown;
+    GLenum blend_dst = unknown;
+    std::array<s32, 4> viewport = {-1, -1, -1, -1};
+
+    u32 issued = 0;
+    u32 elided = 0;
+
+    void set_active_unit(GLuint unit);
+
+    static constexpr std::array<GLuint, max_texture_units>
+    make_unknown_textures()
+    {
+        std::array<GLuint, max_texture_units> t = {};
+        for (GLuint& texture : t) { texture = unknown; }
+        return t;
+    }
+};
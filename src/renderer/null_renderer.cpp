@@ -0,0 +1,15 @@
+#include "renderer/null_renderer.h"
+
+void Null_Renderer::clear_screen() {}
+
+void Null_Renderer::swap_buffer() {}
+
+void Null_Renderer::set_window_size(u32, u32) {}
+
+void Null_Renderer::load_assets() {}
+
+void Null_Renderer::set_board_draw_mode(Board_Draw_Mode) {}
+
+void Null_Renderer::execute(const Render_Command_Buffer&) {}
+
+const Render_Stats& Null_Renderer::get_stats() const { return stats; }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "renderer/renderer.h"
+
+/**
+   Renderer that draws nothing. Lets the game run on a platform without a
+   display, e.g. Headless.
+ */
+class Null_Renderer : public Renderer {
+public:
+    void clear_screen() override;
+    void swap_buffer() override;
+    void set_window_size(u32 w, u32 h) override;
+    void load_assets() override;
+    void set_board_draw_mode(Board_Draw_Mode mode) override;
+    void execute(const Render_Command_Buffer& commands) override;
+    [[nodiscard]] const Render_Stats& get_stats() const override;
+
+private:
+    Render_Stats stats = {};
+};
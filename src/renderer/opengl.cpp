@@ -1,9 +1,10 @@
 #include "renderer/opengl.h"
 
 #include "logger.h"
+#include "perf/profiler.h"
+#include "renderer/atlas.h"
+#include "renderer/tiles.h"
 #include <glm/gtc/type_ptr.hpp> // value_ptr
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb/stb_image.h>
 
 #ifdef _WIN32
 #    include <GL/wglew.h> // Windows OpenGL extensions
@@ -14,12 +15,14 @@
 #endif
 
 #define __USE_MATH_DEFINES // For compatibility with old cmath #defines
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 OpenGl::OpenGl(char const* window_name, Platform* platform) : platform(platform)
 {
-    platform->create_open_gl_rendering_context(window_name, 3, 3, 640, 480);
+    platform->create_open_gl_rendering_context(window_name, 3, 3, window_width,
+                                               window_height);
 
     // Enable expiremental functionality
     glewExperimental = GL_TRUE;
@@ -39,6 +42,8 @@ OpenGl::OpenGl(char const* window_name, Platform* platform) : platform(platform)
                                                  // handling
     }
 
+    GL_CHECK(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size));
+
     // Disbale Vsync by default
     set_vsync(true);
 }
@@ -102,129 +107,14 @@ void OpenGl::set_window_size(u32 w, u32 h) { platform->set_window_size(w, h); }
 
 void OpenGl::clear_screen()
 {
-    GL_CHECK(glClearColor(1.0, 0.0, 0.5, 1.0));
+    state.set_viewport(0, 0, window_width, window_height);
+    GL_CHECK(glClearColor(0.2f, 0.3f, 0.3f, 1.0f));
     GL_CHECK(glClear(GL_COLOR_BUFFER_BIT));
 }
 
-void OpenGl::proto_setup()
+void OpenGl::load_assets()
 {
-    // Build and compile our shader program
-    VertexShader v_shader("res/shaders/basic.vert");
-    FragmentShader f_shader("res/shaders/basic.frag");
-
-    shader = std::make_unique<Shader>(v_shader, f_shader);
-
-    // Set up vertex data (and buffer(s)) and attribute pointers
-    GLfloat constexpr vertices[] = {
-        // Position          //Color            // Texture Coords
-        0.5f,  0.5f,  0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, // Top Right
-        0.5f,  -0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, // Bottom Right
-        -0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, // Bottom Left
-        -0.5f, 0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f  // Top Left
-    };
-    GLuint constexpr indices[] = {
-        0, 1, 3, // First Triangle
-        1, 2, 3  // Second Triangle
-    };
-
-    GLuint vbo;
-    GLuint ebo;
-    GL_CHECK(glGenBuffers(1, &vbo));
-    GL_CHECK(glGenBuffers(1, &ebo));
-    GL_CHECK(glGenVertexArrays(1, &vao));
-    // Bind the Vertex Array Object first, then bind and set vertex buffer(s)
-    // and attribute pointer(s).
-    GL_CHECK(glBindVertexArray(vao));
-    {
-        // Copy vertices to vertex buffer
-        GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vbo));
-        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices,
-                              GL_STATIC_DRAW));
-
-        // Copy indices to element buffer
-        GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo));
-        GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices,
-                              GL_STATIC_DRAW));
-
-        // Set position attribute
-        GL_CHECK(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-                                       8 * sizeof(GLfloat),
-                                       static_cast<GLvoid*>(nullptr)));
-        GL_CHECK(glEnableVertexAttribArray(0));
-        GL_CHECK(glVertexAttribPointer(
-            1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat),
-            reinterpret_cast<GLvoid*>(3 * sizeof(GLfloat))));
-        GL_CHECK(glEnableVertexAttribArray(1));
-        GL_CHECK(glVertexAttribPointer(
-            2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat),
-            reinterpret_cast<GLvoid*>(6 * sizeof(GLfloat))));
-        GL_CHECK(glEnableVertexAttribArray(2));
-        GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER,
-                              0)); // NOTE(sdsmith): vbo bound to vao after
-                                   // glVertexAttribPointer call
-    }
-    GL_CHECK(glBindVertexArray(0));
-    GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-
-    ////////// Texture
-    GL_CHECK(glGenTextures(2, textures));
-
-    //// Create texture 1
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, textures[0]));
-    // Set wrap behavior
-    GL_CHECK(
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GL_CHECK(
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-    // Set sampling behavior
-    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                             GL_LINEAR_MIPMAP_LINEAR));
-    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-    // Load image
-    int tex_width = 0, tex_height = 0, bytes_per_pixel = 0;
-    unsigned char* image = stbi_load("res/textures/container.jpg", &tex_width,
-                                     &tex_height, &bytes_per_pixel, 0);
-    if (image == nullptr) {
-        std::cout << "ERROR::TEXTURE::IMAGE::LOAD_FAILED" << std::endl;
-    }
-    // Generate texture
-    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, tex_width, tex_height, 0,
-                          GL_RGB, GL_UNSIGNED_BYTE, image));
-    // Generate mipmap
-    GL_CHECK(glGenerateMipmap(GL_TEXTURE_2D));
-    // Cleanup
-    stbi_image_free(image);
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
-
-    //// Create texture 2
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, textures[1]));
-    // Set wrap behavior
-    GL_CHECK(
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GL_CHECK(
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-    // Set sampling behavior
-    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                             GL_LINEAR_MIPMAP_LINEAR));
-    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-    // Load image
-    stbi_set_flip_vertically_on_load(true); // flip the image
-    image = stbi_load("res/textures/awesomeface.jpg", &tex_width, &tex_height,
-                      &bytes_per_pixel, 0);
-    if (image == nullptr) {
-        std::cout << "ERROR::TEXTURE::IMAGE::LOAD_FAILED" << std::endl;
-    }
-    // Generate texture
-    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, tex_width, tex_height, 0,
-                          GL_RGB, GL_UNSIGNED_BYTE, image));
-    // Generate mipmap
-    GL_CHECK(glGenerateMipmap(GL_TEXTURE_2D));
-    // Cleanup
-    stbi_image_free(image);
-    stbi_set_flip_vertically_on_load(false);
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    if (tile_texture == 0) { setup_tile_texture(); }
 }
 
 // // TODO(sdsmith): How do we want to handle the textureIDs? Do we allocate all
@@ -249,26 +139,775 @@ void OpenGl::proto_setup()
 
 // }
 
-void OpenGl::proto_draw()
+void OpenGl::setup_overlay()
 {
-    // Render
-    // Clear the colorbuffer
-    GL_CHECK(glClearColor(0.2f, 0.3f, 0.3f, 1.0f));
-    GL_CHECK(glClear(GL_COLOR_BUFFER_BIT));
+    VertexShader v_shader("res/shaders/overlay.vert");
+    FragmentShader f_shader("res/shaders/overlay.frag");
+
+    overlay_shader = std::make_unique<Shader>(v_shader, f_shader);
+    overlay_screen_size_location =
+        overlay_shader->uniform_location("screen_size");
+    // Linking changes the bound program
+    state.invalidate();
+
+    // Attributes point into the stream buffer, at a new offset every draw
+    GL_CHECK(glGenVertexArrays(1, &overlay_vao));
+    state.bind_vertex_array(overlay_vao);
+    GL_CHECK(glEnableVertexAttribArray(0));
+    GL_CHECK(glEnableVertexAttribArray(1));
+}
+
+void OpenGl::draw_overlay(const Overlay_Vertex* vertices, u32 count)
+{
+    PROFILE_FUNCTION();
+
+    if (count == 0) { return; }
+    if (overlay_vao == 0) { setup_overlay(); }
+
+    const GLintptr offset = stream.push(
+        vertices, static_cast<GLsizeiptr>(count * sizeof(Overlay_Vertex)),
+        alignof(Overlay_Vertex));
+
+    state.bind_vertex_array(overlay_vao);
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, stream.get_buffer()));
+    // Position
+    GL_CHECK(glVertexAttribPointer(
+        0, 2, GL_FLOAT, GL_FALSE, sizeof(Overlay_Vertex),
+        reinterpret_cast<GLvoid*>(offset + offsetof(Overlay_Vertex, x))));
+    // Color
+    GL_CHECK(glVertexAttribPointer(
+        1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Overlay_Vertex),
+        reinterpret_cast<GLvoid*>(offset + offsetof(Overlay_Vertex, color))));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+    state.use_program(overlay_shader->get_id());
+    GL_CHECK(glUniform2f(overlay_screen_size_location,
+                         static_cast<GLfloat>(window_width),
+                         static_cast<GLfloat>(window_height)));
+
+    state.set_blend(true);
+    state.set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GL_CHECK(glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count)));
+    frame_stats.draw_calls++;
+}
+
+void OpenGl::setup_tile_texture()
+{
+    // Every tile in one atlas, so the board never rebinds textures
+    Atlas_Builder builder(tile_atlas_padding);
+    u32 pixels[tile_pixels * tile_pixels];
+    for (s32 t = 0; t < tile_count; ++t) {
+        rasterize_tile(static_cast<Tile_Id>(t), pixels, tile_pixels);
+        builder.add_sprite(tile_pixels, tile_pixels, pixels, tile_pixels);
+    }
+
+    Texture_Atlas atlas;
+    if (!builder.build(max_texture_size, &atlas)) {
+        logCritical(LOG_VIDEO, "Tile atlas does not fit in %dx%d\n",
+                    max_texture_size, max_texture_size);
+        return;
+    }
+    for (s32 t = 0; t < tile_count; ++t) {
+        const Atlas_Uv& uv = atlas.uvs[static_cast<std::size_t>(t)];
+        tile_uvs[static_cast<std::size_t>(t)] = {uv.u0, uv.v0, uv.u1, uv.v1};
+    }
+
+    GL_CHECK(glGenTextures(1, &tile_texture));
+    state.edit_texture(tile_atlas_unit, tile_texture);
+    GL_CHECK(
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GL_CHECK(
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                             GL_LINEAR_MIPMAP_LINEAR));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    // Deeper levels would blend neighbouring tiles together
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                             atlas.max_mip_level));
+    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlas.width,
+                          atlas.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                          atlas.pixels.data()));
+    GL_CHECK(glGenerateMipmap(GL_TEXTURE_2D));
+}
+
+void OpenGl::setup_tile_instancing()
+{
+    VertexShader v_shader("res/shaders/tile.vert");
+    FragmentShader f_shader("res/shaders/tile.frag");
+
+    tile_shader = std::make_unique<Shader>(
+        v_shader, f_shader,
+        std::initializer_list<Sampler_Binding>{{"tiles", tile_atlas_unit}});
+    tile_screen_size_location = tile_shader->uniform_location("screen_size");
+    tile_board_origin_location = tile_shader->uniform_location("board_origin");
+    tile_size_location = tile_shader->uniform_location("tile_size");
+    state.invalidate();
+
+    // Atlas coordinates never change
+    state.use_program(tile_shader->get_id());
+    GL_CHECK(glUniform4fv(tile_shader->uniform_location("tile_uv"),
+                          tile_count, &tile_uvs[0][0]));
+
+    // Unit quad as a triangle strip, origin top left
+    GLfloat constexpr corners[] = {0.0f, 0.0f, 1.0f, 0.0f,
+                                   0.0f, 1.0f, 1.0f, 1.0f};
+
+    GL_CHECK(glGenVertexArrays(1, &tile_vao));
+    GL_CHECK(glGenBuffers(1, &tile_quad_vbo));
+    state.bind_vertex_array(tile_vao);
+    {
+        GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, tile_quad_vbo));
+        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners,
+                              GL_STATIC_DRAW));
+        GL_CHECK(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+                                       2 * sizeof(GLfloat), nullptr));
+        GL_CHECK(glEnableVertexAttribArray(0));
+
+        // One Tile_Instance per cell, advanced once per instance. They point
+        // into the stream buffer at draw time.
+        GL_CHECK(glEnableVertexAttribArray(1));
+        GL_CHECK(glVertexAttribDivisor(1, 1));
+        GL_CHECK(glEnableVertexAttribArray(2));
+        GL_CHECK(glVertexAttribDivisor(2, 1));
+        GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    }
+}
+
+void OpenGl::setup_board_texture()
+{
+    VertexShader v_shader("res/shaders/board.vert");
+    FragmentShader f_shader("res/shaders/board.frag");
+
+    board_shader = std::make_unique<Shader>(
+        v_shader, f_shader,
+        std::initializer_list<Sampler_Binding>{
+            {"tiles", tile_atlas_unit}, {"cells", board_cells_unit}});
+    board_screen_size_location = board_shader->uniform_location("screen_size");
+    board_origin_location = board_shader->uniform_location("board_origin");
+    board_tile_size_location = board_shader->uniform_location("tile_size");
+    board_size_location = board_shader->uniform_location("board_size");
+    board_cursor_location = board_shader->uniform_location("cursor");
+    state.invalidate();
+
+    // Constant for the life of the program
+    state.use_program(board_shader->get_id());
+    GL_CHECK(glUniform1ui(board_shader->uniform_location("cursor_tile"),
+                          tile_cursor));
+    GL_CHECK(glUniform4fv(board_shader->uniform_location("tile_uv"),
+                          tile_count, &tile_uvs[0][0]));
+
+    // The full-screen quad is generated from gl_VertexID, but core profile
+    // still needs a vertex array bound to draw.
+    GL_CHECK(glGenVertexArrays(1, &board_vao));
+    GL_CHECK(glGenTextures(1, &board_cell_texture));
+}
+
+void OpenGl::upload_board_cells(const Grid& board, Cell_Rect rect)
+{
+    Memory_Arena* arena = platform->get_frame_arena();
+    Arena_Scope scratch(arena);
+
+    // Bands of whole rows, so a full upload of a huge board needs no more
+    // scratch than a small one. The GL copies each band on upload.
+    const s32 w = rect.x1 - rect.x0;
+    const s32 band_rows =
+        std::min(std::max(board_upload_band_bytes / w, 1), rect.y1 - rect.y0);
+    u8* tiles = arena->push_array<u8>(static_cast<std::size_t>(w) *
+                                      static_cast<std::size_t>(band_rows));
+    for (s32 band_y = rect.y0; band_y < rect.y1; band_y += band_rows) {
+        const s32 h = std::min(band_rows, rect.y1 - band_y);
+        for (s32 y = 0; y < h; ++y) {
+            const u32 row = board.index(rect.x0, band_y + y);
+            for (s32 x = 0; x < w; ++x) {
+                tiles[y * w + x] = cell_tile(board, row + static_cast<u32>(x));
+            }
+        }
+        GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x0, band_y, w, h,
+                                 GL_RED_INTEGER, GL_UNSIGNED_BYTE, tiles));
+    }
+}
+
+void OpenGl::upload_board_texture(const Grid& board)
+{
+    PROFILE_FUNCTION();
+
+    state.edit_texture(board_cells_unit, board_cell_texture);
+    GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    // A different board than last time is uploaded whole
+    if (board_texture_grid != &board ||
+        board_texture_width != board.width() ||
+        board_texture_length != board.length()) {
+        board_texture_grid = &board;
+        board_texture_width = board.width();
+        board_texture_length = board.length();
+
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                                 GL_NEAREST));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                                 GL_NEAREST));
+        GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, board.width(),
+                              board.length(), 0, GL_RED_INTEGER,
+                              GL_UNSIGNED_BYTE, nullptr));
+        upload_board_cells(board, {0, 0, board.width(), board.length()});
+        board_texture_pending.reset(board.chunk_count());
+    } else {
+        for (u32 chunk : board_texture_pending.chunks) {
+            upload_board_cells(board, board.chunk_rect(chunk));
+        }
+        board_texture_pending.clear();
+    }
+
+    GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+}
+
+void OpenGl::compute_board_layout(const Grid& board, const Camera& camera,
+                                  f32* tile_size, f32* origin_x,
+                                  f32* origin_y) const
+{
+    // Zoom 1 is the largest tile size that fits the whole board. Whole
+    // pixels when tiles are at least a pixel so every tile is the same size.
+    f32 size = std::min(
+        static_cast<f32>(window_width) / static_cast<f32>(board.width()),
+        static_cast<f32>(window_height) / static_cast<f32>(board.length()));
+    size *= camera.zoom;
+    f32 x = static_cast<f32>(window_width) / 2.0f - camera.center_x * size;
+    f32 y = static_cast<f32>(window_height) / 2.0f - camera.center_y * size;
+    if (size >= 1.0f) {
+        size = std::floor(size);
+        x = std::round(
+            static_cast<f32>(window_width) / 2.0f - camera.center_x * size);
+        y = std::round(
+            static_cast<f32>(window_height) / 2.0f - camera.center_y * size);
+    }
+
+    *tile_size = size;
+    *origin_x = x;
+    *origin_y = y;
+}
+
+void OpenGl::set_board_draw_mode(Board_Draw_Mode mode)
+{
+    board_draw_mode = mode;
+}
 
-    shader->enable();
+bool OpenGl::board_uses_texture(const Grid& board) const
+{
+    // One texel per cell, so larger boards than a texture can hold are
+    // drawn instanced whatever the mode
+    if (board.width() > max_texture_size ||
+        board.length() > max_texture_size) {
+        return false;
+    }
+
+    if (board_draw_mode == Board_Draw_Mode::automatic) {
+        return board.cell_count() >= board_texture_min_cells;
+    }
+    return board_draw_mode == Board_Draw_Mode::texture;
+}
+
+u64 OpenGl::material_key(const Draw_Item& item) const
+{
+    switch (item.type) {
+        case Draw_Type::board: {
+            f32 tile_size = 0.0f;
+            f32 origin_x = 0.0f;
+            f32 origin_y = 0.0f;
+            compute_board_layout(*item.board, item.camera, &tile_size,
+                                 &origin_x, &origin_y);
+            if (tile_size < overview_max_tile_size) {
+                return make_material_key(program_key_overview,
+                                         texture_key_board_pyramid);
+            }
+            const u8 program = board_uses_texture(*item.board)
+                                   ? program_key_board
+                                   : program_key_tiles;
+            return make_material_key(program, texture_key_tile_atlas);
+        }
+        case Draw_Type::quads: {
+            return make_material_key(program_key_overlay, texture_key_none);
+        }
+        case Draw_Type::minimap: {
+            return make_material_key(program_key_overview,
+                                     texture_key_board_pyramid);
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+void OpenGl::execute(const Render_Command_Buffer& commands)
+{
+    PROFILE_FUNCTION();
+
+    const u32 count = commands.size();
+    if (count == 0) { return; }
+
+    Memory_Arena* arena = platform->get_frame_arena();
+    Arena_Scope scratch(arena);
+
+    Sort_Entry* entries = arena->push_array<Sort_Entry>(count);
+    for (u32 i = 0; i < count; ++i) {
+        entries[i] = {commands[i].key | material_key(commands[i]), i};
+    }
+    radix_sort(entries, arena->push_array<Sort_Entry>(count), count);
+
+    for (u32 i = 0; i < count;) {
+        const Draw_Item& item = commands[entries[i].index];
+
+        // Quads of the same layer and material become one draw
+        u32 end = i + 1;
+        u32 vertex_count = item.vertex_count;
+        if (item.type == Draw_Type::quads) {
+            while (end < count &&
+                   sort_key_batch(entries[end].key) ==
+                       sort_key_batch(entries[i].key)) {
+                vertex_count += commands[entries[end].index].vertex_count;
+                ++end;
+            }
+        }
+
+        switch (item.type) {
+            case Draw_Type::board: {
+                draw_board(*item.board, item.cursor_x, item.cursor_y,
+                           item.camera);
+            } break;
+
+            case Draw_Type::minimap: {
+                draw_minimap(*item.board, item.camera);
+            } break;
+
+            case Draw_Type::quads: {
+                if (end == i + 1) {
+                    draw_overlay(item.vertices, vertex_count);
+                    break;
+                }
+                Overlay_Vertex* vertices =
+                    arena->push_array<Overlay_Vertex>(vertex_count);
+                Overlay_Vertex* out = vertices;
+                for (u32 j = i; j < end; ++j) {
+                    const Draw_Item& part = commands[entries[j].index];
+                    std::copy(part.vertices, part.vertices + part.vertex_count,
+                              out);
+                    out += part.vertex_count;
+                }
+                draw_overlay(vertices, vertex_count);
+            } break;
+
+            default: {
+            } break;
+        }
+        frame_stats.draw_items += end - i;
+        i = end;
+    }
+}
+
+void OpenGl::draw_board(const Grid& board, s32 cursor_x, s32 cursor_y,
+                        const Camera& camera)
+{
+    PROFILE_FUNCTION();
+
+    if (tile_texture == 0) { setup_tile_texture(); }
+    if (tile_texture == 0) { return; }
+
+    f32 tile_size = 0.0f;
+    f32 origin_x = 0.0f;
+    f32 origin_y = 0.0f;
+    compute_board_layout(board, camera, &tile_size, &origin_x, &origin_y);
+
+    record_board_changes(board);
+    if (tile_size < overview_max_tile_size) {
+        draw_overview(board, tile_size, origin_x, origin_y);
+    } else if (board_uses_texture(board)) {
+        draw_board_texture(board, cursor_x, cursor_y, camera);
+    } else {
+        draw_board_instanced(board, cursor_x, cursor_y, camera);
+    }
+}
+
+void OpenGl::record_board_changes(const Grid& board)
+{
+    if (board_changes_frame == frame_index) { return; }
+    board_changes_frame = frame_index;
+
+    // Every path that holds this board keeps the changes until it is next
+    // drawn, so switching paths costs only what changed meanwhile. A path
+    // holding another board starts over when it is used anyway.
+    const bool chunks_hold_board = board_chunk_grid == &board &&
+                                   board_chunk_width == board.width() &&
+                                   board_chunk_length == board.length();
+    const bool texture_holds_board = board_texture_grid == &board &&
+                                     board_texture_width == board.width() &&
+                                     board_texture_length == board.length();
+    const bool pyramid_holds_board = pyramid_grid == &board &&
+                                     pyramid_width == board.width() &&
+                                     pyramid_length == board.length();
+    for (u32 n = 0; n < board.dirty_chunk_count(); ++n) {
+        const u32 chunk = board.dirty_chunk(n);
+        if (chunks_hold_board) { board_chunks[chunk].dirty = true; }
+        if (texture_holds_board) { board_texture_pending.add(chunk); }
+        if (pyramid_holds_board) { pyramid_pending.add(chunk); }
+    }
+}
+
+Cell_Rect OpenGl::visible_cells(const Grid& board, f32 tile_size,
+                                f32 origin_x, f32 origin_y) const
+{
+    const f32 x0 = std::floor(-origin_x / tile_size);
+    const f32 y0 = std::floor(-origin_y / tile_size);
+    const f32 x1 =
+        std::ceil((static_cast<f32>(window_width) - origin_x) / tile_size);
+    const f32 y1 =
+        std::ceil((static_cast<f32>(window_height) - origin_y) / tile_size);
+
+    const f32 width = static_cast<f32>(board.width());
+    const f32 length = static_cast<f32>(board.length());
+    return {static_cast<s32>(std::clamp(x0, 0.0f, width)),
+            static_cast<s32>(std::clamp(y0, 0.0f, length)),
+            static_cast<s32>(std::clamp(x1, 0.0f, width)),
+            static_cast<s32>(std::clamp(y1, 0.0f, length))};
+}
+
+void OpenGl::build_board_chunk(const Grid& board, s32 chunk_x, s32 chunk_y)
+{
+    Board_Chunk& chunk = board_chunks[static_cast<std::size_t>(
+        chunk_y * board_chunk_columns + chunk_x)];
+
+    const s32 x0 = chunk_x * board_chunk_cells;
+    const s32 y0 = chunk_y * board_chunk_cells;
+    const s32 w = std::min(board_chunk_cells, board.width() - x0);
+    const s32 h = std::min(board_chunk_cells, board.length() - y0);
+
+    Memory_Arena* arena = platform->get_frame_arena();
+    Arena_Scope scratch(arena);
+
+    chunk.instance_count = w * h;
+    Tile_Instance* instances = arena->push_array<Tile_Instance>(
+        static_cast<std::size_t>(chunk.instance_count));
+    for (s32 y = 0; y < h; ++y) {
+        const u32 row = board.index(x0, y0 + y);
+        for (s32 x = 0; x < w; ++x) {
+            instances[y * w + x] = {static_cast<u16>(x0 + x),
+                                    static_cast<u16>(y0 + y),
+                                    cell_tile(board, row + static_cast<u32>(x)),
+                                    {}};
+        }
+    }
+
+    // Replacing the whole store lets the driver orphan the old one instead of
+    // waiting for draws still reading it
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo));
+    GL_CHECK(glBufferData(
+        GL_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(static_cast<std::size_t>(chunk.instance_count) *
+                                sizeof(Tile_Instance)),
+        instances, GL_DYNAMIC_DRAW));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    chunk.dirty = false;
+    frame_stats.chunk_rebuilds++;
+}
+
+void OpenGl::update_board_chunks(const Grid& board)
+{
+    PROFILE_FUNCTION();
+
+    // A different board than last time starts with every chunk dirty
+    if (board_chunk_grid != &board || board_chunk_width != board.width() ||
+        board_chunk_length != board.length()) {
+        for (Board_Chunk& chunk : board_chunks) {
+            GL_CHECK(glDeleteBuffers(1, &chunk.vbo));
+        }
+
+        board_chunk_grid = &board;
+        board_chunk_width = board.width();
+        board_chunk_length = board.length();
+        board_chunk_columns =
+            (board.width() + board_chunk_cells - 1) / board_chunk_cells;
+        const s32 rows =
+            (board.length() + board_chunk_cells - 1) / board_chunk_cells;
+        const Board_Chunk unbuilt = {0, 0, true};
+        board_chunks.assign(
+            static_cast<std::size_t>(board_chunk_columns * rows), unbuilt);
+        for (Board_Chunk& chunk : board_chunks) {
+            GL_CHECK(glGenBuffers(1, &chunk.vbo));
+        }
+    }
+}
+
+void OpenGl::draw_board_instanced(const Grid& board, s32 cursor_x,
+                                  s32 cursor_y, const Camera& camera)
+{
+    if (tile_vao == 0) { setup_tile_instancing(); }
+
+    update_board_chunks(board);
+
+    f32 tile_size = 0.0f;
+    f32 origin_x = 0.0f;
+    f32 origin_y = 0.0f;
+    compute_board_layout(board, camera, &tile_size, &origin_x, &origin_y);
+
+    state.use_program(tile_shader->get_id());
+    GL_CHECK(glUniform2f(tile_screen_size_location,
+                         static_cast<GLfloat>(window_width),
+                         static_cast<GLfloat>(window_height)));
+    GL_CHECK(glUniform2f(tile_board_origin_location, origin_x, origin_y));
+    GL_CHECK(glUniform1f(tile_size_location, tile_size));
+
+    state.bind_texture(tile_atlas_unit, tile_texture);
+    state.set_blend(true);
+    state.set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    state.bind_vertex_array(tile_vao);
+
+    // Only chunks that overlap the window
+    const Cell_Rect view = visible_cells(board, tile_size, origin_x, origin_y);
+    if (!view.empty()) {
+        for (s32 cy = view.y0 / board_chunk_cells;
+             cy <= (view.y1 - 1) / board_chunk_cells; ++cy) {
+            for (s32 cx = view.x0 / board_chunk_cells;
+                 cx <= (view.x1 - 1) / board_chunk_cells; ++cx) {
+                Board_Chunk& chunk = board_chunks[static_cast<std::size_t>(
+                    cy * board_chunk_columns + cx)];
+                if (chunk.dirty) { build_board_chunk(board, cx, cy); }
+                GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo));
+                GL_CHECK(glVertexAttribIPointer(
+                    1, 2, GL_UNSIGNED_SHORT, sizeof(Tile_Instance),
+                    reinterpret_cast<GLvoid*>(offsetof(Tile_Instance, x))));
+                GL_CHECK(glVertexAttribIPointer(
+                    2, 1, GL_UNSIGNED_BYTE, sizeof(Tile_Instance),
+                    reinterpret_cast<GLvoid*>(offsetof(Tile_Instance, tile))));
+                GL_CHECK(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4,
+                                               chunk.instance_count));
+                frame_stats.draw_calls++;
+            }
+        }
+    }
+
+    // Cursor last so it is blended over its cell
+    const Tile_Instance cursor = {static_cast<u16>(cursor_x),
+                                  static_cast<u16>(cursor_y), tile_cursor, {}};
+    const GLintptr offset =
+        stream.push(&cursor, sizeof(cursor), alignof(Tile_Instance));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, stream.get_buffer()));
+    GL_CHECK(glVertexAttribIPointer(
+        1, 2, GL_UNSIGNED_SHORT, sizeof(Tile_Instance),
+        reinterpret_cast<GLvoid*>(offset + offsetof(Tile_Instance, x))));
+    GL_CHECK(glVertexAttribIPointer(
+        2, 1, GL_UNSIGNED_BYTE, sizeof(Tile_Instance),
+        reinterpret_cast<GLvoid*>(offset + offsetof(Tile_Instance, tile))));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GL_CHECK(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, 1));
+    frame_stats.draw_calls++;
+}
+
+void OpenGl::draw_board_texture(const Grid& board, s32 cursor_x, s32 cursor_y,
+                                const Camera& camera)
+{
+    if (board_vao == 0) { setup_board_texture(); }
+
+    upload_board_texture(board);
+
+    f32 tile_size = 0.0f;
+    f32 origin_x = 0.0f;
+    f32 origin_y = 0.0f;
+    compute_board_layout(board, camera, &tile_size, &origin_x, &origin_y);
+
+    state.use_program(board_shader->get_id());
+    GL_CHECK(glUniform2f(board_screen_size_location,
+                         static_cast<GLfloat>(window_width),
+                         static_cast<GLfloat>(window_height)));
+    GL_CHECK(glUniform2f(board_origin_location, origin_x, origin_y));
+    GL_CHECK(glUniform1f(board_tile_size_location, tile_size));
+    GL_CHECK(glUniform2i(board_size_location, board.width(), board.length()));
+    GL_CHECK(glUniform2i(board_cursor_location, cursor_x, cursor_y));
+
+    state.bind_texture(tile_atlas_unit, tile_texture);
+    state.bind_texture(board_cells_unit, board_cell_texture);
+
+    // Every pixel is opaque
+    state.set_blend(false);
+    state.bind_vertex_array(board_vao);
+    GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+    frame_stats.draw_calls++;
+}
 
-    // Bind texture with texture units
-    GL_CHECK(glActiveTexture(GL_TEXTURE0));
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, textures[0]));
-    GL_CHECK(glUniform1i(glGetUniformLocation(shader->get_id(), "tex1"), 0));
-    GL_CHECK(glActiveTexture(GL_TEXTURE1));
-    GL_CHECK(glBindTexture(GL_TEXTURE_2D, textures[1]));
-    GL_CHECK(glUniform1i(glGetUniformLocation(shader->get_id(), "tex2"), 1));
+void OpenGl::setup_overview()
+{
+    VertexShader v_shader("res/shaders/board.vert");
+    FragmentShader f_shader("res/shaders/overview.frag");
+
+    overview_shader = std::make_unique<Shader>(
+        v_shader, f_shader,
+        std::initializer_list<Sampler_Binding>{
+            {"summary", board_pyramid_unit}});
+    overview_screen_size_location =
+        overview_shader->uniform_location("screen_size");
+    overview_origin_location =
+        overview_shader->uniform_location("board_origin");
+    overview_tile_size_location =
+        overview_shader->uniform_location("tile_size");
+    overview_board_size_location =
+        overview_shader->uniform_location("board_size");
+    state.invalidate();
+
+    GL_CHECK(glGenVertexArrays(1, &overview_vao));
+    GL_CHECK(glGenTextures(1, &pyramid_texture));
+}
+
+void OpenGl::update_board_pyramid(const Grid& board)
+{
+    PROFILE_FUNCTION();
+
+    // A different board than last time is summarized whole
+    const bool rebuild = pyramid_grid != &board ||
+                         pyramid_width != board.width() ||
+                         pyramid_length != board.length();
+    if (rebuild) {
+        pyramid_grid = &board;
+        pyramid_width = board.width();
+        pyramid_length = board.length();
+        pyramid.build(board, platform->get_permanent_arena());
+        pyramid_pending.reset(board.chunk_count());
+    } else {
+        for (u32 chunk : pyramid_pending.chunks) {
+            pyramid.update(board, board.chunk_rect(chunk));
+        }
+    }
+
+    state.edit_texture(board_pyramid_unit, pyramid_texture);
+    const std::size_t level_count = pyramid.get_level_count();
+    if (rebuild) {
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
+                                 GL_CLAMP_TO_EDGE));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
+                                 GL_CLAMP_TO_EDGE));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                                 GL_LINEAR_MIPMAP_LINEAR));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                                 GL_NEAREST));
+
+        // Levels too big for a texture are left out. Sampling is normalized,
+        // so the next level down stands in for them.
+        pyramid_base_level = 0;
+        while (pyramid.get_level(pyramid_base_level).width >
+                   max_texture_size ||
+               pyramid.get_level(pyramid_base_level).length >
+                   max_texture_size) {
+            pyramid_base_level++;
+        }
+        GL_CHECK(glTexParameteri(
+            GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+            static_cast<GLint>(level_count - pyramid_base_level) - 1));
+        for (std::size_t l = pyramid_base_level; l < level_count; ++l) {
+            const Board_Pyramid::Level& level = pyramid.get_level(l);
+            GL_CHECK(glTexImage2D(
+                GL_TEXTURE_2D, static_cast<GLint>(l - pyramid_base_level),
+                GL_RGBA8, level.width, level.length, 0, GL_RGBA,
+                GL_UNSIGNED_BYTE, level.texels));
+        }
+    } else {
+        // Only the changed chunks, straight out of each level. Chunks share
+        // texels on the coarse levels; those few are uploaded again.
+        for (u32 chunk : pyramid_pending.chunks) {
+            const Cell_Rect cells = board.chunk_rect(chunk);
+            for (std::size_t l = pyramid_base_level; l < level_count; ++l) {
+                const Board_Pyramid::Level& level = pyramid.get_level(l);
+                const Cell_Rect rect = pyramid.level_rect(l, cells);
+
+                GL_CHECK(glPixelStorei(GL_UNPACK_ROW_LENGTH, level.width));
+                GL_CHECK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x0));
+                GL_CHECK(glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y0));
+                GL_CHECK(glTexSubImage2D(
+                    GL_TEXTURE_2D, static_cast<GLint>(l - pyramid_base_level),
+                    rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0,
+                    GL_RGBA, GL_UNSIGNED_BYTE, level.texels));
+            }
+        }
+        GL_CHECK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+        GL_CHECK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+        GL_CHECK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+        pyramid_pending.clear();
+    }
+}
+
+void OpenGl::draw_overview(const Grid& board, f32 tile_size, f32 origin_x,
+                           f32 origin_y)
+{
+    if (overview_vao == 0) { setup_overview(); }
+
+    update_board_pyramid(board);
+
+    state.use_program(overview_shader->get_id());
+    GL_CHECK(glUniform2f(overview_screen_size_location,
+                         static_cast<GLfloat>(window_width),
+                         static_cast<GLfloat>(window_height)));
+    GL_CHECK(glUniform2f(overview_origin_location, origin_x, origin_y));
+    GL_CHECK(glUniform1f(overview_tile_size_location, tile_size));
+    GL_CHECK(glUniform2f(overview_board_size_location,
+                         static_cast<GLfloat>(board.width()),
+                         static_cast<GLfloat>(board.length())));
+
+    state.bind_texture(board_pyramid_unit, pyramid_texture);
+    state.set_blend(false);
+    state.bind_vertex_array(overview_vao);
+    GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+    frame_stats.draw_calls++;
+}
 
-    GL_CHECK(glBindVertexArray(vao));
-    GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
-    GL_CHECK(glBindVertexArray(0));
+void OpenGl::draw_minimap(const Grid& board, const Camera& camera)
+{
+    PROFILE_FUNCTION();
+
+    record_board_changes(board);
+
+    // Whole board in the bottom right corner
+    const f32 width = static_cast<f32>(board.width());
+    const f32 length = static_cast<f32>(board.length());
+    const f32 scale = minimap_size / std::max(width, length);
+    const f32 map_x =
+        std::round(static_cast<f32>(window_width) - minimap_margin -
+                   width * scale);
+    const f32 map_y =
+        std::round(static_cast<f32>(window_height) - minimap_margin -
+                   length * scale);
+    draw_overview(board, scale, map_x, map_y);
+
+    // Outline what the camera sees, in board cells
+    f32 tile_size = 0.0f;
+    f32 origin_x = 0.0f;
+    f32 origin_y = 0.0f;
+    compute_board_layout(board, camera, &tile_size, &origin_x, &origin_y);
+    const f32 view_x0 = std::clamp(-origin_x / tile_size, 0.0f, width);
+    const f32 view_y0 = std::clamp(-origin_y / tile_size, 0.0f, length);
+    const f32 view_x1 = std::clamp(
+        (static_cast<f32>(window_width) - origin_x) / tile_size, 0.0f, width);
+    const f32 view_y1 = std::clamp(
+        (static_cast<f32>(window_height) - origin_y) / tile_size, 0.0f, length);
+    const f32 x0 = map_x + view_x0 * scale;
+    const f32 y0 = map_y + view_y0 * scale;
+    const f32 x1 = map_x + view_x1 * scale;
+    const f32 y1 = map_y + view_y1 * scale;
+
+    constexpr u32 outline_color = 0xff00e0ff;
+    const f32 edges[4][4] = {{x0, y0, x1 - x0, 1.0f},
+                             {x0, y1 - 1.0f, x1 - x0, 1.0f},
+                             {x0, y0, 1.0f, y1 - y0},
+                             {x1 - 1.0f, y0, 1.0f, y1 - y0}};
+    Overlay_Vertex vertices[4 * 6];
+    for (u32 e = 0; e < 4; ++e) {
+        const f32 ex0 = edges[e][0];
+        const f32 ey0 = edges[e][1];
+        const f32 ex1 = ex0 + edges[e][2];
+        const f32 ey1 = ey0 + edges[e][3];
+        Overlay_Vertex* v = &vertices[e * 6];
+        v[0] = {ex0, ey0, outline_color};
+        v[1] = {ex1, ey0, outline_color};
+        v[2] = {ex0, ey1, outline_color};
+        v[3] = {ex1, ey0, outline_color};
+        v[4] = {ex1, ey1, outline_color};
+        v[5] = {ex0, ey1, outline_color};
+    }
+    draw_overlay(vertices, 4 * 6);
 }
 
 GLfloat OpenGl::calc_frustum_scale(GLfloat fov_degree)
@@ -276,10 +915,25 @@ GLfloat OpenGl::calc_frustum_scale(GLfloat fov_degree)
     const GLfloat degree_to_radian = static_cast<GLfloat>(M_PI * 2.0f / 360.0f);
     GLfloat fov_radian = fov_degree * degree_to_radian;
 
-    return 1.0f / tan(fov_radian / 2.0f);
+    return 1.0f / std::tan(fov_radian / 2.0f);
+}
+
+void OpenGl::swap_buffer()
+{
+    PROFILE_FUNCTION();
+    stream.end_frame();
+    platform->swap_window_buffer();
+
+    frame_index++;
+
+    frame_stats.state_changes = state.get_issued();
+    frame_stats.state_changes_elided = state.get_elided();
+    state.reset_counters();
+    last_frame_stats = frame_stats;
+    frame_stats = {};
 }
 
-void OpenGl::swap_buffer() { platform->swap_window_buffer(); }
+const Render_Stats& OpenGl::get_stats() const { return last_frame_stats; }
 
 void OpenGl::set_vsync(bool enable)
 {
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "renderer/board_pyramid.h"
+#include "renderer/gl_state_cache.h"
 #include "renderer/renderer.h"
 #include "renderer/shader.h"
+#include "renderer/stream_buffer.h"
+#include "renderer/tiles.h"
 #include <glm/glm.hpp>
 #define GLEW_STATIC // Use GLEW static library
 #include <GL/glew.h>
+#include <array>
 #include <cstddef>
-#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #ifdef _DEBUG
 #    define CHECK_GL_ERROR(description) \
@@ -23,17 +28,177 @@
 #    define GL_CHECK(statement) statement
 #endif
 
+// Space around each tile in the atlas, which bounds the usable mip levels
+constexpr s32 tile_atlas_padding = 4;
+
+// Texture units, fixed per sampler when each program is linked
+constexpr GLuint tile_atlas_unit = 0;
+constexpr GLuint board_cells_unit = 1;
+constexpr GLuint board_pyramid_unit = 2;
+
+// Most bytes of tile ids staged at once when uploading the board texture
+constexpr s32 board_upload_band_bytes = 256 * 1024;
+
+// Below this many pixels per cell the board is drawn from its Board_Pyramid
+// instead of cell by cell
+constexpr f32 overview_max_tile_size = 2.0f;
+// Longest side of the minimap and its distance from the window corner
+constexpr f32 minimap_size = 160.0f;
+constexpr f32 minimap_margin = 8.0f;
+
+// Shader and texture fields of draw item sort keys
+enum Program_Key : u8 {
+    program_key_tiles = 1,
+    program_key_board,
+    program_key_overview,
+    program_key_overlay
+};
+enum Texture_Key : u16 {
+    texture_key_none,
+    texture_key_tile_atlas,
+    texture_key_board_pyramid
+};
+
+/**
+   Tile instances of one chunk of the board, kept on the GPU until one of
+   its cells changes.
+ */
+struct Board_Chunk {
+    GLuint vbo;
+    GLsizei instance_count;
+    // Cells changed since the last build. Built when next in view.
+    bool dirty;
+};
+
+// Changed chunks of the board a draw path has yet to pick up, each listed
+// once, so a path that was not drawn for a while catches up on just those
+struct Pending_Chunks {
+    std::vector<bool> listed;
+    std::vector<u32> chunks;
+
+    void reset(u32 chunk_count)
+    {
+        listed.assign(chunk_count, false);
+        chunks.clear();
+    }
+    void add(u32 chunk)
+    {
+        if (listed[chunk]) { return; }
+        listed[chunk] = true;
+        chunks.push_back(chunk);
+    }
+    void clear()
+    {
+        for (u32 chunk : chunks) { listed[chunk] = false; }
+        chunks.clear();
+    }
+};
+
 // TODO(stewarts): Why do most of these functions return void???
 class OpenGl : public Renderer {
 private:
     Platform* platform;
+    Gl_State_Cache state{};
+    // Vertex and instance data rewritten every frame
+    Stream_Buffer stream{};
+
+    s32 window_width = 640;
+    s32 window_height = 480;
+    // Largest width or height of a texture this context accepts
+    GLint max_texture_size = 0;
+
+    // Overlay
+    std::unique_ptr<Shader> overlay_shader{};
+    GLuint overlay_vao = 0;
+    GLint overlay_screen_size_location = -1;
+
+    // Board tiles
+    std::unique_ptr<Shader> tile_shader{};
+    GLuint tile_vao = 0;
+    GLuint tile_quad_vbo = 0;
+    // Tile atlas and the atlas coordinates of each tile, by Tile_Id
+    GLuint tile_texture = 0;
+    std::array<std::array<GLfloat, 4>, tile_count> tile_uvs{};
+    GLint tile_screen_size_location = -1;
+    GLint tile_board_origin_location = -1;
+    GLint tile_size_location = -1;
+    // Row-major, board_chunk_columns per row
+    std::vector<Board_Chunk> board_chunks{};
+    // Board the chunks hold. Any other board is rebuilt whole.
+    const Grid* board_chunk_grid = nullptr;
+    s32 board_chunk_width = 0;
+    s32 board_chunk_length = 0;
+    s32 board_chunk_columns = 0;
+
+    // Board as a texture of tile ids
+    Board_Draw_Mode board_draw_mode = Board_Draw_Mode::automatic;
+    std::unique_ptr<Shader> board_shader{};
+    GLuint board_vao = 0;
+    GLuint board_cell_texture = 0;
+    // Board the texture holds. Any other board is uploaded whole.
+    const Grid* board_texture_grid = nullptr;
+    s32 board_texture_width = 0;
+    s32 board_texture_length = 0;
+    Pending_Chunks board_texture_pending{};
+    GLint board_screen_size_location = -1;
+    GLint board_origin_location = -1;
+    GLint board_tile_size_location = -1;
+    GLint board_size_location = -1;
+    GLint board_cursor_location = -1;
+
+    // Board summary, for boards too far zoomed out to draw cells and for
+    // the minimap
+    std::unique_ptr<Shader> overview_shader{};
+    GLuint overview_vao = 0;
+    GLuint pyramid_texture = 0;
+    Board_Pyramid pyramid{};
+    // Board the pyramid holds. Any other board is summarized whole.
+    const Grid* pyramid_grid = nullptr;
+    s32 pyramid_width = 0;
+    s32 pyramid_length = 0;
+    Pending_Chunks pyramid_pending{};
+    // First pyramid level within max_texture_size; texture level 0 holds it
+    std::size_t pyramid_base_level = 0;
+    // Board changes are recorded at most once a frame
+    u64 frame_index = 0;
+    u64 board_changes_frame = ~0ull;
+    GLint overview_screen_size_location = -1;
+    GLint overview_origin_location = -1;
+    GLint overview_tile_size_location = -1;
+    GLint overview_board_size_location = -1;
 
-    // TEMP
-    GLuint vao = std::numeric_limits<GLuint>::max();
-    std::unique_ptr<Shader> shader;
-    GLuint textures[2];
+    Render_Stats frame_stats = {};
+    Render_Stats last_frame_stats = {};
 
     GLfloat calc_frustum_scale(GLfloat fov_degree);
+    void setup_overlay();
+    void setup_tile_texture();
+    void setup_tile_instancing();
+    void setup_board_texture();
+    void upload_board_texture(const Grid& board);
+    void upload_board_cells(const Grid& board, Cell_Rect rect);
+    void compute_board_layout(const Grid& board, const Camera& camera,
+                              f32* tile_size, f32* origin_x,
+                              f32* origin_y) const;
+    [[nodiscard]] Cell_Rect visible_cells(const Grid& board, f32 tile_size,
+                                          f32 origin_x, f32 origin_y) const;
+    void record_board_changes(const Grid& board);
+    void update_board_chunks(const Grid& board);
+    void build_board_chunk(const Grid& board, s32 chunk_x, s32 chunk_y);
+    [[nodiscard]] bool board_uses_texture(const Grid& board) const;
+    [[nodiscard]] u64 material_key(const Draw_Item& item) const;
+    void draw_board(const Grid& board, s32 cursor_x, s32 cursor_y,
+                    const Camera& camera);
+    void draw_overlay(const Overlay_Vertex* vertices, u32 count);
+    void draw_board_instanced(const Grid& board, s32 cursor_x, s32 cursor_y,
+                              const Camera& camera);
+    void draw_board_texture(const Grid& board, s32 cursor_x, s32 cursor_y,
+                            const Camera& camera);
+    void setup_overview();
+    void update_board_pyramid(const Grid& board);
+    void draw_overview(const Grid& board, f32 tile_size, f32 origin_x,
+                       f32 origin_y);
+    void draw_minimap(const Grid& board, const Camera& camera);
 
 public:
     OpenGl(char const* window_name, Platform* platform);
@@ -45,8 +210,10 @@ public:
     void swap_buffer() override;
     void set_vsync(bool enable);
     void set_window_size(u32 w, u32 h) override;
-    void proto_setup() override;
-    void proto_draw() override;
+    void load_assets() override;
+    void set_board_draw_mode(Board_Draw_Mode mode) override;
+    void execute(const Render_Command_Buffer& commands) override;
+    [[nodiscard]] const Render_Stats& get_stats() const override;
 
     OpenGl& operator=(const OpenGl& o) = delete;
 };
@@ -0,0 +1,131 @@
+#include "renderer/perf_overlay.h"
+
+#include "perf/profiler.h"
+#include "renderer/bitmap_font.h"
+#include <algorithm>
+#include <cstdio>
+
+// Worst case text plus graph
+static constexpr u32 max_quads = 2048;
+
+static constexpr u32 panel_color = 0xb0000000;
+static constexpr u32 text_color = 0xffffffff;
+static constexpr u32 graph_ok_color = 0xff40d040;
+static constexpr u32 graph_slow_color = 0xff4040e0;
+static constexpr u32 target_line_color = 0xff40e0e0;
+
+void Perf_Overlay::push_frame_time(f32 ms)
+{
+    frame_history[history_head] = ms;
+    history_head = (history_head + 1) % history_length;
+}
+
+void Perf_Overlay::add_quad(f32 x, f32 y, f32 w, f32 h, u32 color)
+{
+    if (vertex_count + 6 > max_quads * 6) { return; }
+
+    Overlay_Vertex* v = vertices + vertex_count;
+    v[0] = {x, y, color};
+    v[1] = {x + w, y, color};
+    v[2] = {x, y + h, color};
+    v[3] = {x + w, y, color};
+    v[4] = {x + w, y + h, color};
+    v[5] = {x, y + h, color};
+    vertex_count += 6;
+}
+
+f32 Perf_Overlay::add_text(f32 x, f32 y, f32 scale, u32 color,
+                           char const* text)
+{
+    for (char const* c = text; *c != '\0'; ++c) {
+        const u16 bits = glyph_bits(*c);
+
+        for (s32 row = 0; row < glyph_height; ++row) {
+            // Merge horizontal runs of lit pixels into one quad
+            s32 col = 0;
+            while (col < glyph_width) {
+                if (!glyph_pixel(bits, col, row)) {
+                    col++;
+                    continue;
+                }
+
+                const s32 run_start = col;
+                while (col < glyph_width && glyph_pixel(bits, col, row)) {
+                    col++;
+                }
+                add_quad(x + static_cast<f32>(run_start) * scale,
+                         y + static_cast<f32>(row) * scale,
+                         static_cast<f32>(col - run_start) * scale, scale,
+                         color);
+            }
+        }
+
+        x += static_cast<f32>(glyph_width + 1) * scale;
+    }
+
+    return x;
+}
+
+void Perf_Overlay::build(const Perf_Overlay_Data& data, Memory_Arena* arena)
+{
+    PROFILE_FUNCTION();
+
+    constexpr f32 margin = 8.0f;
+    constexpr f32 padding = 6.0f;
+    constexpr f32 scale = 2.0f;
+    constexpr f32 line_height = (glyph_height + 2) * scale;
+    constexpr f32 bar_width = 2.0f;
+    constexpr f32 graph_height = 48.0f;
+    constexpr f32 graph_width = history_length * bar_width;
+    constexpr s32 line_count = 6;
+
+    vertices = arena->push_array<Overlay_Vertex>(max_quads * 6);
+    vertex_count = 0;
+
+    add_quad(margin, margin, graph_width + 2 * padding,
+             line_count * line_height + graph_height + 3 * padding,
+             panel_color);
+
+    char line[64];
+    f32 y = margin + padding;
+    const f32 x = margin + padding;
+    const f32 fps =
+        (data.frame_time_ms > 0.0f) ? 1000.0f / data.frame_time_ms : 0.0f;
+
+    snprintf(line, sizeof(line), "FRAME %6.2f MS",
+             static_cast<f64>(data.frame_time_ms));
+    add_text(x, y, scale, text_color, line);
+    y += line_height;
+    snprintf(line, sizeof(line), "P99   %6.2f MS",
+             static_cast<f64>(data.p99_frame_time_ms));
+    add_text(x, y, scale, text_color, line);
+    y += line_height;
+    snprintf(line, sizeof(line), "FPS   %6.1f", static_cast<f64>(fps));
+    add_text(x, y, scale, text_color, line);
+    y += line_height;
+    snprintf(line, sizeof(line), "DRAWS %6u", data.draw_calls);
+    add_text(x, y, scale, text_color, line);
+    y += line_height;
+    snprintf(line, sizeof(line), "STATE %6u/%u", data.state_changes,
+             data.state_changes_elided);
+    add_text(x, y, scale, text_color, line);
+    y += line_height;
+    snprintf(line, sizeof(line), "MEM   %6.1f MB",
+             static_cast<f64>(data.peak_memory_bytes) / (1024.0 * 1024.0));
+    add_text(x, y, scale, text_color, line);
+    y += line_height + padding;
+
+    // Frame time graph, oldest on the left. Full height is twice the target
+    // frame time.
+    const f32 graph_scale_ms = 2.0f * data.target_frame_time_ms;
+    for (std::size_t i = 0; i < history_length; ++i) {
+        const f32 ms = frame_history[(history_head + i) % history_length];
+        const f32 h =
+            std::min(ms / graph_scale_ms, 1.0f) * graph_height;
+        add_quad(x + static_cast<f32>(i) * bar_width, y + graph_height - h,
+                 bar_width, h,
+                 (ms <= data.target_frame_time_ms) ? graph_ok_color
+                                                   : graph_slow_color);
+    }
+    add_quad(x, y + graph_height / 2.0f, graph_width, 1.0f, target_line_color);
+}
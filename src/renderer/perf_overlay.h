@@ -0,0 +1,58 @@
+#pragma once
+
+#include "memory_arena.h"
+#include "types.h"
+#include <array>
+
+/**
+   Vertex of the 2D overlay geometry. Positions are in window pixels with the
+   origin at the top left; color is RGBA8 packed as 0xAABBGGRR.
+ */
+struct Overlay_Vertex {
+    f32 x;
+    f32 y;
+    u32 color;
+};
+
+struct Perf_Overlay_Data {
+    f32 frame_time_ms;
+    f32 p99_frame_time_ms;
+    f32 target_frame_time_ms;
+    u32 draw_calls;
+    u32 state_changes;
+    u32 state_changes_elided;
+    u64 peak_memory_bytes;
+};
+
+/**
+   Performance overlay: frame time, p99, a frame time graph, draw calls, GL
+   state changes made and skipped, and the memory high-water mark.
+
+   The overlay is flat-colored quads built on the CPU into one vertex buffer,
+   so a renderer can draw all of it as a single triangle list. Text uses the
+   built-in bitmap font with horizontal pixel runs merged into one quad. The
+   vertices are allocated from the arena passed to build() and stay valid
+   until that arena is reset, normally at the end of the frame.
+ */
+class Perf_Overlay {
+public:
+    static constexpr std::size_t history_length = 120;
+
+    void push_frame_time(f32 ms);
+    void build(const Perf_Overlay_Data& data, Memory_Arena* arena);
+
+    [[nodiscard]] const Overlay_Vertex* get_vertices() const
+    {
+        return vertices;
+    }
+    [[nodiscard]] u32 get_vertex_count() const { return vertex_count; }
+
+private:
+    Overlay_Vertex* vertices = nullptr;
+    u32 vertex_count = 0;
+    std::array<f32, history_length> frame_history = {};
+    std::size_t history_head = 0;
+
+    void add_quad(f32 x, f32 y, f32 w, f32 h, u32 color);
+    f32 add_text(f32 x, f32 y, f32 scale, u32 color, char const* text);
+};
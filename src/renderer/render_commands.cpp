@@ -0,0 +1,80 @@
+#include "renderer/render_commands.h"
+
+#include <array>
+#include <utility>
+
+void Render_Command_Buffer::push_board(u32 depth, const Grid* board,
+                                       s32 cursor_x, s32 cursor_y,
+                                       const Camera& camera)
+{
+    Draw_Item item = {};
+    item.key = make_sort_key(Render_Layer::board, 0, 0, depth);
+    item.type = Draw_Type::board;
+    item.board = board;
+    item.cursor_x = cursor_x;
+    item.cursor_y = cursor_y;
+    item.camera = camera;
+    items.push(item);
+}
+
+void Render_Command_Buffer::push_quads(Render_Layer layer, u32 depth,
+                                       const Overlay_Vertex* vertices,
+                                       u32 count)
+{
+    if (count == 0) { return; }
+
+    Draw_Item item = {};
+    item.key = make_sort_key(layer, 0, 0, depth);
+    item.type = Draw_Type::quads;
+    item.vertices = vertices;
+    item.vertex_count = count;
+    items.push(item);
+}
+
+void Render_Command_Buffer::push_minimap(Render_Layer layer, u32 depth,
+                                         const Grid* board,
+                                         const Camera& camera)
+{
+    Draw_Item item = {};
+    item.key = make_sort_key(layer, 0, 0, depth);
+    item.type = Draw_Type::minimap;
+    item.board = board;
+    item.camera = camera;
+    items.push(item);
+}
+
+void radix_sort(Sort_Entry* entries, Sort_Entry* scratch, u32 count)
+{
+    if (count < 2) { return; }
+
+    // Bytes that differ between any two keys
+    u64 varying = 0;
+    for (u32 i = 1; i < count; ++i) {
+        varying |= entries[i].key ^ entries[0].key;
+    }
+
+    Sort_Entry* src = entries;
+    Sort_Entry* dst = scratch;
+    for (u32 shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xff) == 0) { continue; }
+
+        std::array<u32, 256> offsets = {};
+        for (u32 i = 0; i < count; ++i) {
+            offsets[(src[i].key >> shift) & 0xff]++;
+        }
+        u32 total = 0;
+        for (u32& offset : offsets) {
+            const u32 n = offset;
+            offset = total;
+            total += n;
+        }
+        for (u32 i = 0; i < count; ++i) {
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != entries) {
+        for (u32 i = 0; i < count; ++i) { entries[i] = src[i]; }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "game/grid.h"
+#include "memory_arena.h"
+#include "renderer/camera.h"
+#include "renderer/perf_overlay.h"
+#include "types.h"
+
+/**
+   Layers draw in order, each on top of the previous ones.
+ */
+enum class Render_Layer : u8 { board, overlay };
+
+enum class Draw_Type : u8 {
+    // The cells of a board seen through a camera, and the cursor
+    board,
+    // Screen-space triangle list. Consecutive lists with the same layer and
+    // material are merged into one draw call.
+    quads,
+    // Whole board in a window corner, with the camera's view outlined
+    minimap
+};
+
+/**
+   Sort key, most significant first:
+
+       | layer 8 | shader 8 | texture 16 | depth 32 |
+
+   Sorting by key draws layer by layer, and within a layer groups items by
+   material so state changes once per group. Depth orders items that share
+   a material; items with different materials in the same layer should not
+   overlap.
+ */
+constexpr u32 sort_key_depth_bits = 32;
+
+constexpr u64 make_material_key(u8 shader, u16 texture)
+{
+    return (static_cast<u64>(shader) << 48) | (static_cast<u64>(texture) << 32);
+}
+
+constexpr u64 make_sort_key(Render_Layer layer, u8 shader, u16 texture,
+                            u32 depth)
+{
+    return (static_cast<u64>(layer) << 56) |
+           make_material_key(shader, texture) | static_cast<u64>(depth);
+}
+
+// Layer and material: items with equal batch keys may share a draw call
+constexpr u64 sort_key_batch(u64 key) { return key >> sort_key_depth_bits; }
+
+struct Draw_Item {
+    u64 key;
+    Draw_Type type;
+    // board, minimap
+    const Grid* board;
+    s32 cursor_x;
+    s32 cursor_y;
+    Camera camera;
+    // quads
+    const Overlay_Vertex* vertices;
+    u32 vertex_count;
+};
+
+/**
+   Draw items for one frame, recorded by the game and executed by a
+   Renderer.
+
+   The submitter chooses the layer and depth of each item. Which shader and
+   texture an item needs is up to the backend, which fills those fields of
+   the key in before sorting. Items and anything they point to live until
+   the arena is reset, normally at the end of the frame.
+ */
+class Render_Command_Buffer {
+public:
+    explicit Render_Command_Buffer(Memory_Arena* arena) : items(arena) {}
+    Render_Command_Buffer(const Render_Command_Buffer& o) = delete;
+
+    void push_board(u32 depth, const Grid* board, s32 cursor_x, s32 cursor_y,
+                    const Camera& camera);
+    void push_quads(Render_Layer layer, u32 depth,
+                    const Overlay_Vertex* vertices, u32 count);
+    void push_minimap(Render_Layer layer, u32 depth, const Grid* board,
+                      const Camera& camera);
+
+    [[nodiscard]] u32 size() const { return items.size(); }
+    [[nodiscard]] const Draw_Item& operator[](u32 i) const
+    {
+        return items[i];
+    }
+
+    Render_Command_Buffer& operator=(const Render_Command_Buffer& o) = delete;
+
+private:
+    Arena_Stack<Draw_Item> items;
+};
+
+struct Sort_Entry {
+    u64 key;
+    u32 index;
+};
+
+/**
+   Stable LSD radix sort by key, a byte per pass. Passes where every key has
+   the same byte are skipped, so keys that only differ in a few fields sort
+   in a few passes. scratch must hold count entries.
+ */
+void radix_sort(Sort_Entry* entries, Sort_Entry* scratch, u32 count);
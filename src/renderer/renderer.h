@@ -1,6 +1,34 @@
 #pragma once
 
+#include "game/grid.h"
 #include "platform/platform.h"
+#include "renderer/perf_overlay.h"
+#include "renderer/render_commands.h"
+
+struct Render_Stats {
+    u32 draw_calls;
+    // Items executed from command buffers, often fewer draws after batching
+    u32 draw_items;
+    // Board chunks whose tile instances were rebuilt
+    u32 chunk_rebuilds;
+    // GL state changes made, and skipped because the state was already set
+    u32 state_changes;
+    u32 state_changes_elided;
+};
+
+enum class Board_Draw_Mode : u8 {
+    // Texture for boards of at least board_texture_min_cells, else instanced
+    automatic,
+    // One instance per cell, cached per board_chunk_cells square chunk and
+    // rebuilt only when a cell in it changes
+    instanced,
+    // One texel per cell, updated where cells changed, drawn as a single
+    // full-screen quad. For boards too big to stream. Boards wider or longer
+    // than the GPU's texture size limit are drawn instanced instead.
+    texture
+};
+
+constexpr u32 board_texture_min_cells = 1u << 20;
 
 class Renderer {
 public:
@@ -9,6 +37,11 @@ public:
     virtual void clear_screen() = 0;
     virtual void swap_buffer() = 0;
     virtual void set_window_size(u32 w, u32 h) = 0;
-    virtual void proto_setup() = 0;
-    virtual void proto_draw() = 0;
+    // Create textures and other resources up front rather than on first use
+    virtual void load_assets() = 0;
+    virtual void set_board_draw_mode(Board_Draw_Mode mode) = 0;
+    // Sort the items by key, merge what can share a draw call and draw them
+    virtual void execute(const Render_Command_Buffer& commands) = 0;
+    // Stats of the last frame presented by swap_buffer
+    [[nodiscard]] virtual const Render_Stats& get_stats() const = 0;
 };
@@ -1,6 +1,7 @@
 #include "renderer/shader.h"
 
 #include "renderer/opengl.h"
+#include <cstring>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -76,17 +77,15 @@ FragmentShader::FragmentShader(std::string const &file_path)
 }
 
 Shader::Shader(std::string const &vertex_file_path,
-               std::string const &fragment_file_path)
-    : program_id(0)
-{
-    VertexShader v_shader(vertex_file_path);
-    FragmentShader f_shader(fragment_file_path);
-
-    Shader(v_shader, f_shader);
-}
+               std::string const &fragment_file_path,
+               std::initializer_list<Sampler_Binding> samplers)
+    : Shader(VertexShader(vertex_file_path),
+             FragmentShader(fragment_file_path), samplers)
+{}
 
 Shader::Shader(VertexShader const &vertex_shader,
-               FragmentShader const &fragment_shader)
+               FragmentShader const &fragment_shader,
+               std::initializer_list<Sampler_Binding> samplers)
     : program_id(0)
 {
     // Link shaders and create program
@@ -111,7 +110,84 @@ Shader::Shader(VertexShader const &vertex_shader,
             glGetProgramInfoLog(program_id, log_length, nullptr, info_log.data()));
         std::cout << "ERROR::SHADER::PROGRAM::LINK_FAILED\n"
                   << info_log.data() << std::endl;
+        return;
+    }
+
+    reflect();
+    bind_samplers(samplers);
+}
+
+static void read_variable(GLuint program, GLuint index, bool uniform,
+                          Shader_Variable* var)
+{
+    GLsizei length = 0;
+    if (uniform) {
+        GL_CHECK(glGetActiveUniform(program, index, sizeof(var->name), &length,
+                                    &var->array_size, &var->type, var->name));
+    } else {
+        GL_CHECK(glGetActiveAttrib(program, index, sizeof(var->name), &length,
+                                   &var->array_size, &var->type, var->name));
+    }
+
+    // Arrays are reported as "name[0]"
+    char* bracket = std::strchr(var->name, '[');
+    if (bracket != nullptr) { *bracket = '\0'; }
+}
+
+void Shader::reflect()
+{
+    GLint count = 0;
+    GL_CHECK(glGetProgramiv(program_id, GL_ACTIVE_UNIFORMS, &count));
+    uniforms.resize(static_cast<std::size_t>(count));
+    for (GLint i = 0; i < count; ++i) {
+        Shader_Variable& var = uniforms[static_cast<std::size_t>(i)];
+        read_variable(program_id, static_cast<GLuint>(i), true, &var);
+        var.location = glGetUniformLocation(program_id, var.name);
+    }
+
+    GL_CHECK(glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTES, &count));
+    attributes.resize(static_cast<std::size_t>(count));
+    for (GLint i = 0; i < count; ++i) {
+        Shader_Variable& var = attributes[static_cast<std::size_t>(i)];
+        read_variable(program_id, static_cast<GLuint>(i), false, &var);
+        var.location = glGetAttribLocation(program_id, var.name);
+    }
+}
+
+void Shader::bind_samplers(std::initializer_list<Sampler_Binding> samplers)
+{
+    if (samplers.size() == 0) { return; }
+
+    GL_CHECK(glUseProgram(program_id));
+    for (const Sampler_Binding& sampler : samplers) {
+        const GLint location = uniform_location(sampler.name);
+        if (location < 0) {
+            std::cout << "WARNING::SHADER::PROGRAM::NO_SAMPLER '"
+                      << sampler.name << "'\n";
+            continue;
+        }
+        GL_CHECK(glUniform1i(location, static_cast<GLint>(sampler.unit)));
+    }
+    GL_CHECK(glUseProgram(0));
+}
+
+static GLint find_location(const std::vector<Shader_Variable>& variables,
+                           char const* name)
+{
+    for (const Shader_Variable& var : variables) {
+        if (std::strcmp(var.name, name) == 0) { return var.location; }
     }
+    return -1;
+}
+
+GLint Shader::uniform_location(char const* name) const
+{
+    return find_location(uniforms, name);
+}
+
+GLint Shader::attribute_location(char const* name) const
+{
+    return find_location(attributes, name);
 }
 
 GLuint Shader::get_id() const { return program_id; }
@@ -3,8 +3,10 @@
 
 #include <GL/glew.h>
 #include <fstream>
+#include <initializer_list>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // TODO(stewarts): Why do most of these functions return void???
 
@@ -32,20 +34,65 @@ public:
     FragmentShader(std::string const &filepath);
 };
 
+// Texture unit a sampler uniform reads from
+struct Sampler_Binding {
+    char const* name;
+    GLuint unit;
+};
+
+// Active uniform or attribute of a linked program
+struct Shader_Variable {
+    // Arrays are listed once, under their name without the "[0]"
+    char name[32];
+    GLint location;
+    GLenum type;
+    GLint array_size;
+};
+
+/**
+   Linked shader program.
+
+   The active uniforms and attributes are enumerated once at link time, so
+   callers look up locations in that table when they set up instead of
+   asking the driver by name. Samplers are assigned their texture units at
+   link time and never change afterwards.
+ */
 class Shader {
 public:
     Shader(std::string const &vertex_file_path,
-           std::string const &fragment_file_path);
+           std::string const &fragment_file_path,
+           std::initializer_list<Sampler_Binding> samplers = {});
     Shader(VertexShader const &vertex_shader,
-           FragmentShader const &fragment_shader);
+           FragmentShader const &fragment_shader,
+           std::initializer_list<Sampler_Binding> samplers = {});
+    Shader(const Shader& o) = delete;
     ~Shader();
 
     [[nodiscard]] GLuint get_id() const;
     void enable();
     static void disable();
 
+    // -1 if the program has no such active uniform/attribute
+    [[nodiscard]] GLint uniform_location(char const* name) const;
+    [[nodiscard]] GLint attribute_location(char const* name) const;
+    [[nodiscard]] const std::vector<Shader_Variable>& get_uniforms() const
+    {
+        return uniforms;
+    }
+    [[nodiscard]] const std::vector<Shader_Variable>& get_attributes() const
+    {
+        return attributes;
+    }
+
+    Shader& operator=(const Shader& o) = delete;
+
 private:
     GLuint program_id;
+    std::vector<Shader_Variable> uniforms{};
+    std::vector<Shader_Variable> attributes{};
+
+    void reflect();
+    void bind_samplers(std::initializer_list<Sampler_Binding> samplers);
 };
 
 #endif
@@ -0,0 +1,138 @@
+#include "renderer/stream_buffer.h"
+#include "renderer/opengl.h"
+
+#include "logger.h"
+#include <cassert>
+#include <cstring>
+
+Stream_Buffer::~Stream_Buffer() { destroy(); }
+
+void Stream_Buffer::create(GLsizeiptr size)
+{
+    segment_size = size;
+    segment = 0;
+    used = 0;
+    persistent = (GLEW_ARB_buffer_storage != GL_FALSE);
+
+    const GLsizeiptr total = segment_size * segment_count;
+    GL_CHECK(glGenBuffers(1, &buffer));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+    if (persistent) {
+        const GLbitfield flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GL_CHECK(glBufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags));
+        GL_CHECK(mapping = static_cast<u8*>(
+                     glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags)));
+        if (mapping == nullptr) {
+            logCritical(LOG_VIDEO,
+                        "Persistent map of stream buffer failed, falling "
+                        "back to mapping per write\n");
+            persistent = false;
+            GL_CHECK(glDeleteBuffers(1, &buffer));
+            GL_CHECK(glGenBuffers(1, &buffer));
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+        }
+    }
+    if (!persistent) {
+        GL_CHECK(
+            glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW));
+    }
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void Stream_Buffer::destroy()
+{
+    for (GLsync& fence : fences) {
+        if (fence != nullptr) {
+            GL_CHECK(glDeleteSync(fence));
+            fence = nullptr;
+        }
+    }
+    if (buffer != 0) {
+        // Deleting unmaps. Draws already issued keep the storage alive.
+        GL_CHECK(glDeleteBuffers(1, &buffer));
+        buffer = 0;
+    }
+    mapping = nullptr;
+}
+
+void Stream_Buffer::wait(u32 s)
+{
+    if (fences[s] == nullptr) { return; }
+
+    constexpr GLuint64 timeout_ns = 1000000;
+    for (;;) {
+        GLenum result = GL_WAIT_FAILED;
+        GL_CHECK(result = glClientWaitSync(
+                     fences[s], GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns));
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            break;
+        }
+        if (result == GL_WAIT_FAILED) {
+            logCritical(LOG_VIDEO, "Waiting on stream buffer fence failed\n");
+            break;
+        }
+    }
+    GL_CHECK(glDeleteSync(fences[s]));
+    fences[s] = nullptr;
+}
+
+void* Stream_Buffer::map(GLsizeiptr size, GLsizeiptr align, GLintptr* offset)
+{
+    assert(!mapped);
+    assert(align > 0 && (align & (align - 1)) == 0);
+
+    GLsizeiptr start = (used + align - 1) & ~(align - 1);
+    if (buffer == 0 || start + size > segment_size) {
+        // Orphan the old buffer; draws already issued from it still complete
+        GLsizeiptr new_size =
+            (segment_size > 0) ? segment_size : min_segment_size;
+        while (new_size < start + size) { new_size *= 2; }
+        destroy();
+        create(new_size);
+        start = 0;
+    }
+
+    used = start + size;
+    *offset = static_cast<GLintptr>(segment * segment_size + start);
+    mapped = true;
+    if (persistent) { return mapping + *offset; }
+
+    void* p = nullptr;
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+    GL_CHECK(p = glMapBufferRange(GL_ARRAY_BUFFER, *offset, size,
+                                  GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                                      GL_MAP_INVALIDATE_RANGE_BIT));
+    return p;
+}
+
+void Stream_Buffer::unmap()
+{
+    assert(mapped);
+    mapped = false;
+    if (persistent) { return; }
+
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+    GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+GLintptr Stream_Buffer::push(const void* data, GLsizeiptr size,
+                             GLsizeiptr align)
+{
+    GLintptr offset = 0;
+    void* p = map(size, align, &offset);
+    if (p != nullptr) { std::memcpy(p, data, static_cast<std::size_t>(size)); }
+    unmap();
+    return offset;
+}
+
+void Stream_Buffer::end_frame()
+{
+    if (buffer == 0) { return; }
+
+    GL_CHECK(fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    segment = (segment + 1) % segment_count;
+    used = 0;
+    wait(segment);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "types.h"
+#define GLEW_STATIC // Use GLEW static library
+#include <GL/glew.h>
+#include <array>
+
+/**
+   Vertex buffer for data written once per frame, as a ring of
+   segment_count segments: the CPU fills one segment while the GPU may still
+   read the previous ones. A fence marks the end of each frame's segment,
+   and the CPU only waits if it laps the GPU.
+
+   With ARB_buffer_storage the buffer is mapped once, persistently and
+   coherently. Otherwise each write maps its range unsynchronized, which is
+   safe for the same reason. Either way the buffer is never reallocated per
+   frame; it only grows when a frame needs more than a segment holds.
+ */
+class Stream_Buffer {
+public:
+    static constexpr u32 segment_count = 3;
+
+    Stream_Buffer() = default;
+    Stream_Buffer(const Stream_Buffer& o) = delete;
+    ~Stream_Buffer();
+
+    /**
+       Reserve size bytes of this frame's segment, at an offset into
+       get_buffer() that is a multiple of align (a power of two).
+
+       \return Pointer to write the data through until unmap().
+     */
+    void* map(GLsizeiptr size, GLsizeiptr align, GLintptr* offset);
+    void unmap();
+    // Copy into this frame's segment; returns the offset
+    GLintptr push(const void* data, GLsizeiptr size, GLsizeiptr align);
+
+    // Fence this frame's writes and move to the next segment
+    void end_frame();
+
+    [[nodiscard]] GLuint get_buffer() const { return buffer; }
+
+    Stream_Buffer& operator=(const Stream_Buffer& o) = delete;
+
+private:
+    static constexpr GLsizeiptr min_segment_size = 1 << 20;
+
+    GLuint buffer = 0;
+    bool persistent = false;
+    // Whole buffer, while persistently mapped
+    u8* mapping = nullptr;
+    bool mapped = false;
+    GLsizeiptr segment_size = 0;
+    u32 segment = 0;
+    // Bytes used in the current segment
+    GLsizeiptr used = 0;
+    std::array<GLsync, segment_count> fences = {};
+
+    void create(GLsizeiptr size);
+    void destroy();
+    void wait(u32 s);
+};
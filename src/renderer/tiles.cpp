@@ -0,0 +1,151 @@
+#include "renderer/tiles.h"
+
+#include "renderer/bitmap_font.h"
+#include <algorithm>
+
+static constexpr u32 hidden_color = 0xffc6c6c6;
+static constexpr u32 light_edge_color = 0xffffffff;
+static constexpr u32 dark_edge_color = 0xff7b7b7b;
+static constexpr u32 revealed_color = 0xffbdbdbd;
+static constexpr u32 grid_line_color = 0xff7b7b7b;
+static constexpr u32 mine_color = 0xff000000;
+static constexpr u32 mine_hit_color = 0xff0000ff;
+static constexpr u32 flag_color = 0xff0000ff;
+static constexpr u32 cursor_color = 0xff00e0ff;
+
+// Classic digit colors for 1 to 8 adjacent mines
+static constexpr u32 digit_colors[8] = {
+    0xffff0000, 0xff007b00, 0xff0000ff, 0xff7b0000,
+    0xff00007b, 0xff7b7b00, 0xff000000, 0xff7b7b7b};
+
+Tile_Id cell_tile(const Grid& board, u32 i)
+{
+    switch (board.get_state(i)) {
+        case Cell_State::hidden: return tile_hidden;
+        case Cell_State::flagged: return tile_flag;
+        case Cell_State::revealed: {
+            const char value = board.get(i);
+            if (value == mine_val) { return tile_mine_hit; }
+            return static_cast<Tile_Id>(tile_revealed_0 + value);
+        }
+        default: return tile_hidden;
+    }
+}
+
+static void fill_rect(u32* pixels, s32 stride, s32 x, s32 y, s32 w, s32 h,
+                      u32 color)
+{
+    for (s32 row = y; row < y + h; ++row) {
+        for (s32 col = x; col < x + w; ++col) {
+            pixels[row * stride + col] = color;
+        }
+    }
+}
+
+static void draw_raised(u32* pixels, s32 stride)
+{
+    constexpr s32 edge = 2;
+    fill_rect(pixels, stride, 0, 0, tile_pixels, tile_pixels, hidden_color);
+    fill_rect(pixels, stride, 0, 0, tile_pixels, edge, light_edge_color);
+    fill_rect(pixels, stride, 0, 0, edge, tile_pixels, light_edge_color);
+    fill_rect(pixels, stride, 0, tile_pixels - edge, tile_pixels, edge,
+              dark_edge_color);
+    fill_rect(pixels, stride, tile_pixels - edge, 0, edge, tile_pixels,
+              dark_edge_color);
+}
+
+static void draw_flat(u32* pixels, s32 stride, u32 color)
+{
+    fill_rect(pixels, stride, 0, 0, tile_pixels, tile_pixels, color);
+    fill_rect(pixels, stride, 0, 0, tile_pixels, 1, grid_line_color);
+    fill_rect(pixels, stride, 0, 0, 1, tile_pixels, grid_line_color);
+}
+
+static void draw_mine(u32* pixels, s32 stride)
+{
+    constexpr s32 center = tile_pixels / 2;
+    constexpr s32 radius = tile_pixels / 4;
+    for (s32 y = 0; y < tile_pixels; ++y) {
+        for (s32 x = 0; x < tile_pixels; ++x) {
+            const s32 dx = x - center;
+            const s32 dy = y - center;
+            if (dx * dx + dy * dy <= radius * radius) {
+                pixels[y * stride + x] = mine_color;
+            }
+        }
+    }
+}
+
+static void draw_digit(u32* pixels, s32 stride, s32 digit)
+{
+    constexpr s32 scale = 2;
+    constexpr s32 x0 = (tile_pixels - glyph_width * scale) / 2;
+    constexpr s32 y0 = (tile_pixels - glyph_height * scale) / 2;
+
+    const u16 bits = glyph_bits(static_cast<char>('0' + digit));
+    for (s32 y = 0; y < glyph_height; ++y) {
+        for (s32 x = 0; x < glyph_width; ++x) {
+            if (!glyph_pixel(bits, x, y)) { continue; }
+            fill_rect(pixels, stride, x0 + x * scale, y0 + y * scale, scale,
+                      scale, digit_colors[digit - 1]);
+        }
+    }
+}
+
+void rasterize_tile(Tile_Id tile, u32* pixels, s32 stride)
+{
+    switch (tile) {
+        case tile_hidden: {
+            draw_raised(pixels, stride);
+        } break;
+
+        case tile_flag: {
+            draw_raised(pixels, stride);
+            // Pole, base and pennant
+            fill_rect(pixels, stride, 8, 3, 1, 9, mine_color);
+            fill_rect(pixels, stride, 5, 12, 7, 1, mine_color);
+            for (s32 row = 0; row < 5; ++row) {
+                const s32 w = 1 + 2 * std::min(row, 4 - row);
+                fill_rect(pixels, stride, 8 - w, 3 + row, w, 1, flag_color);
+            }
+        } break;
+
+        case tile_mine: {
+            draw_flat(pixels, stride, revealed_color);
+            draw_mine(pixels, stride);
+        } break;
+
+        case tile_mine_hit: {
+            draw_flat(pixels, stride, mine_hit_color);
+            draw_mine(pixels, stride);
+        } break;
+
+        case tile_cursor: {
+            constexpr s32 edge = 2;
+            fill_rect(pixels, stride, 0, 0, tile_pixels, tile_pixels, 0);
+            fill_rect(pixels, stride, 0, 0, tile_pixels, edge, cursor_color);
+            fill_rect(pixels, stride, 0, tile_pixels - edge, tile_pixels, edge,
+                      cursor_color);
+            fill_rect(pixels, stride, 0, 0, edge, tile_pixels, cursor_color);
+            fill_rect(pixels, stride, tile_pixels - edge, 0, edge, tile_pixels,
+                      cursor_color);
+        } break;
+
+        case tile_revealed_0:
+        case tile_revealed_1:
+        case tile_revealed_2:
+        case tile_revealed_3:
+        case tile_revealed_4:
+        case tile_revealed_5:
+        case tile_revealed_6:
+        case tile_revealed_7:
+        case tile_revealed_8: {
+            draw_flat(pixels, stride, revealed_color);
+            const s32 digit = tile - tile_revealed_0;
+            if (digit > 0) { draw_digit(pixels, stride, digit); }
+        } break;
+
+        case tile_count:
+        default: break;
+    }
+}
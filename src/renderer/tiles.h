@@ -0,0 +1,57 @@
+#pragma once
+
+#include "game/grid.h"
+#include "types.h"
+
+/**
+   Board tile images, in the order they appear in the tile texture.
+ */
+enum Tile_Id : u8 {
+    tile_hidden = 0,
+    // Revealed cells with 0 to 8 adjacent mines
+    tile_revealed_0,
+    tile_revealed_1,
+    tile_revealed_2,
+    tile_revealed_3,
+    tile_revealed_4,
+    tile_revealed_5,
+    tile_revealed_6,
+    tile_revealed_7,
+    tile_revealed_8,
+    tile_flag,
+    tile_mine,
+    tile_mine_hit,
+    // Drawn over the cell under the cursor; transparent inside
+    tile_cursor,
+
+    tile_count
+};
+// Shaders size their per-tile arrays for this many
+static_assert(tile_count <= 16, "Update tile_uv in the tile shaders");
+
+// Size of the source art for each tile
+constexpr s32 tile_pixels = 16;
+
+// Cells per side of a chunk of the instanced board, the unit that is rebuilt
+// when cells change and culled against the view. The same chunks as the
+// grid's dirty chunks, so their indices match.
+constexpr s32 board_chunk_cells = grid_chunk_cells;
+
+/**
+   Per-instance data of the tile renderer: which tile to draw in which cell.
+ */
+struct Tile_Instance {
+    u16 x;
+    u16 y;
+    u8 tile;
+    u8 reserved[3];
+};
+static_assert(sizeof(Tile_Instance) == 8, "Tile_Instance is a GPU format");
+
+Tile_Id cell_tile(const Grid& board, u32 i);
+
+/**
+   Draw the art of a tile into an RGBA8 (0xAABBGGRR) image of
+   tile_pixels x tile_pixels, with the given row stride in pixels.
+ */
+void rasterize_tile(Tile_Id tile, u32* pixels, s32 stride);
@@ -0,0 +1,108 @@
+#include "simulate.h"
+
+#include "game/auto_player.h"
+#include "game/game.h"
+#include "game/grid.h"
+#include "job_system.h"
+#include "memory_arena.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+static constexpr u64 games_per_chunk = 64;
+static constexpr std::size_t scratch_arena_capacity = 4 * 1024 * 1024;
+// Board and journal of one game at a time. Address space only; pages are
+// committed as a game first needs them and reused by the next game.
+static constexpr std::size_t storage_arena_capacity = 1ull << 30;
+
+namespace {
+    // Padded so per-thread totals never share a cache line
+    struct alignas(64) Thread_Totals {
+        u64 games = 0;
+        u64 wins = 0;
+        u64 moves = 0;
+    };
+} // namespace
+
+static void simulate_chunk(const Simulation_Config& config, u64 chunk,
+                           Thread_Totals* totals)
+{
+    std::seed_seq seed{static_cast<u32>(config.seed),
+                       static_cast<u32>(config.seed >> 32),
+                       static_cast<u32>(chunk), static_cast<u32>(chunk >> 32)};
+    std::mt19937 rand_gen(seed);
+    Memory_Arena scratch(scratch_arena_capacity);
+    Memory_Arena storage(storage_arena_capacity);
+
+    const u64 first = chunk * games_per_chunk;
+    const u64 last = std::min(first + games_per_chunk, config.games);
+    for (u64 g = first; g < last; ++g) {
+        Arena_Scope game_scope(&storage);
+        Game game(gen_board(config.board_length, config.board_width,
+                            config.num_mines, rand_gen, &storage),
+                  config.num_mines, &storage, &scratch);
+
+        totals->moves += play_game(&game, rand_gen);
+        totals->games++;
+        if (game.status() == Game_Status::won) { totals->wins++; }
+    }
+}
+
+Simulation_Result run_simulation(const Simulation_Config& config)
+{
+    u32 thread_count = config.threads;
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const u64 chunk_count =
+        (config.games + games_per_chunk - 1) / games_per_chunk;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // The calling thread helps while waiting, so it counts as one of the
+    // threads. Totals are indexed by Job_System::current_thread_index().
+    Job_System jobs(thread_count - 1);
+    std::vector<Thread_Totals> totals(thread_count);
+    Task_Group group;
+    for (u64 chunk = 0; chunk < chunk_count; ++chunk) {
+        jobs.run(&group, [&config, &jobs, &totals, chunk] {
+            simulate_chunk(config, chunk,
+                           &totals[jobs.current_thread_index()]);
+        });
+    }
+    jobs.wait(&group);
+
+    const auto end = std::chrono::steady_clock::now();
+
+    Simulation_Result result = {};
+    result.threads = thread_count;
+    result.seconds = std::chrono::duration<f64>(end - start).count();
+    for (const Thread_Totals& t : totals) {
+        result.games += t.games;
+        result.wins += t.wins;
+        result.moves += t.moves;
+    }
+
+    return result;
+}
+
+void print_simulation_result(const Simulation_Result& result)
+{
+    const f64 games = static_cast<f64>(result.games);
+    const f64 moves = static_cast<f64>(result.moves);
+
+    printf("simulated %llu games on %u threads in %.3fs\n",
+           static_cast<unsigned long long>(result.games), result.threads,
+           result.seconds);
+    printf("  %.1f games/s, win rate %.2f%%, %.1f moves/game, %.3f us/move "
+           "(per thread)\n",
+           games / result.seconds,
+           (games > 0) ? 100.0 * static_cast<f64>(result.wins) / games : 0.0,
+           (games > 0) ? moves / games : 0.0,
+           (moves > 0) ? result.seconds * 1.0e6 * result.threads / moves
+                       : 0.0);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "types.h"
+
+struct Simulation_Config {
+    s32 board_length;
+    s32 board_width;
+    s32 num_mines;
+    u64 games;
+    // 0 uses every hardware thread
+    u32 threads;
+    u64 seed;
+};
+
+struct Simulation_Result {
+    u64 games;
+    u64 wins;
+    u64 moves;
+    u32 threads;
+    f64 seconds;
+};
+
+/**
+   Generate and auto-play games in parallel, without a platform or renderer.
+
+   Games are split into fixed-size chunks that run as jobs on a Job_System.
+   Each chunk seeds its own RNG from (seed, chunk index), so the set of
+   games played is the same for any thread count and scheduling.
+ */
+Simulation_Result run_simulation(const Simulation_Config& config);
+void print_simulation_result(const Simulation_Result& result);
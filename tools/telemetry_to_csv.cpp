@@ -0,0 +1,60 @@
+// Converts a telemetry file written by Telemetry_Sink to CSV on stdout.
+//
+// usage: telemetry_to_csv <telemetry file>
+
+#include "perf/telemetry.h"
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <telemetry file>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Unable to open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    Telemetry_File_Header header = {};
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, telemetry_magic, sizeof(header.magic)) !=
+            0) {
+        fprintf(stderr, "'%s' is not a telemetry file\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+    // Records are append-only, so an older file holds a prefix of the
+    // current record and the fields it lacks read as zero
+    const u32 record_size = header.record_size;
+    if (header.version > telemetry_version ||
+        record_size > sizeof(Telemetry_Record) ||
+        record_size < sizeof(Telemetry_Record::frame_index)) {
+        fprintf(stderr, "Unsupported telemetry version %u (record size %u)\n",
+                header.version, record_size);
+        fclose(file);
+        return 1;
+    }
+
+    printf("frame_index,frame_time_us,update_time_us,render_time_us,"
+           "swap_time_us,cells_revealed,draw_calls\n");
+
+    unsigned char bytes[256 * sizeof(Telemetry_Record)];
+    std::size_t count;
+    while ((count = fread(bytes, record_size, 256, file)) > 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            Telemetry_Record r = {};
+            std::memcpy(&r, bytes + i * record_size, record_size);
+            printf("%llu,%u,%u,%u,%u,%u,%u\n",
+                   static_cast<unsigned long long>(r.frame_index),
+                   r.frame_time_us, r.update_time_us, r.render_time_us,
+                   r.swap_time_us, r.cells_revealed, r.draw_calls);
+        }
+    }
+
+    fclose(file);
+    return 0;
+}